@@ -0,0 +1,332 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+
+#include "../core/SAMUEL.h"
+
+using namespace HAYDEN;
+namespace fs = std::filesystem;
+
+// Upper bound for -j, more threads than this only adds contention
+const size_t MaxWorkerCount = 256;
+
+// Command line options for samuel-cli
+struct CLIOptions
+{
+    std::vector<std::string> ResourcePaths;
+    std::vector<std::string> NamePatterns;
+    std::vector<int> Versions;                      // empty = all supported types
+    fs::path OutputDirectory = "exports";
+    size_t WorkerCount = 0;
+    ImageExportFormat ImageFormat = ImageExportFormat::PNG;
+    ModelExportFormat ModelFormat = ModelExportFormat::OBJ;
+    bool WriteMaterialDecls = 1;
+    bool ListOnly = 0;
+    bool UseCache = 1;
+};
+
+void printUsage()
+{
+    printf(
+        "Usage: samuel-cli [options] <file.resources> [<file.resources> ...]\n"
+        "\n"
+        "Exports files from DOOM Eternal .resources archives.\n"
+        "All archives must be located in the same game's \"base\" directory.\n"
+        "\n"
+        "Options:\n"
+        "  -o, --output <dir>          Output directory (default: ./exports).\n"
+        "                              Models are written to a \"modelExports\" folder next to it.\n"
+        "  -n, --name <pattern>        Only export files whose name matches this pattern. * and ? are wildcards.\n"
+        "                              Can be given more than once.\n"
+        "  -t, --type <type>           Only export this type: decl, comp, image or model.\n"
+        "                              Can be given more than once.\n"
+        "  -j, --threads <count>       Number of export threads (default: one per hardware thread).\n"
+        "      --image-format <fmt>    png (default) or dds.\n"
+        "      --model-format <fmt>    obj (default) or glb.\n"
+        "      --no-material-decls     Don't write material2 .decls next to exported models.\n"
+        "  -l, --list                  Print matching files instead of exporting them.\n"
+        "      --no-cache              Don't use the .resources index cache or the decompressed data cache.\n"
+        "  -h, --help                  Show this message.\n"
+    );
+}
+
+// Maps a --type argument to .resources entry versions. Return 0 if unknown.
+bool parseType(const std::string& type, std::vector<int>& versions)
+{
+    if (type == "decl")
+        versions.push_back(0);
+    else if (type == "comp")
+        versions.push_back(1);
+    else if (type == "image")
+        versions.push_back(21);
+    else if (type == "model")
+        versions.insert(versions.end(), { 31, 67 });
+    else
+        return 0;
+    return 1;
+}
+
+// Glob match with * (any run of characters) and ? (any single character)
+bool matchPattern(const std::string& name, const std::string& pattern)
+{
+    size_t n = 0, p = 0;
+    size_t starPattern = std::string::npos, starName = 0;
+
+    while (n < name.size())
+    {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n]))
+        {
+            n++;
+            p++;
+        }
+        else if (p < pattern.size() && pattern[p] == '*')
+        {
+            starPattern = p++;
+            starName = n;
+        }
+        else if (starPattern != std::string::npos)
+        {
+            // Let the last * take one more character
+            p = starPattern + 1;
+            n = ++starName;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    while (p < pattern.size() && pattern[p] == '*')
+        p++;
+
+    return p == pattern.size();
+}
+
+// Whether an entry was selected by the --name and --type options
+bool isSelected(const ResourceEntry& entry, const CLIOptions& options)
+{
+    if (!options.Versions.empty() && std::find(options.Versions.begin(), options.Versions.end(), (int)entry.Version) == options.Versions.end())
+        return 0;
+
+    if (options.NamePatterns.empty())
+        return 1;
+
+    for (int i = 0; i < options.NamePatterns.size(); i++)
+    {
+        if (matchPattern(entry.Name, options.NamePatterns[i]))
+            return 1;
+    }
+    return 0;
+}
+
+// Return 0 on invalid arguments
+bool parseArguments(int argc, char* argv[], CLIOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        // Options that take a value
+        auto nextValue = [&](std::string& value) -> bool {
+            if (i + 1 >= argc)
+            {
+                fprintf(stderr, "Error: %s requires a value.\n", arg.c_str());
+                return 0;
+            }
+            value = argv[++i];
+            return 1;
+        };
+
+        std::string value;
+        if (arg == "-h" || arg == "--help")
+        {
+            printUsage();
+            exit(0);
+        }
+        else if (arg == "-o" || arg == "--output")
+        {
+            if (!nextValue(value))
+                return 0;
+            options.OutputDirectory = value;
+        }
+        else if (arg == "-n" || arg == "--name")
+        {
+            if (!nextValue(value))
+                return 0;
+            options.NamePatterns.push_back(value);
+        }
+        else if (arg == "-t" || arg == "--type")
+        {
+            if (!nextValue(value))
+                return 0;
+            if (!parseType(value, options.Versions))
+            {
+                fprintf(stderr, "Error: unknown type \"%s\".\n", value.c_str());
+                return 0;
+            }
+        }
+        else if (arg == "-j" || arg == "--threads")
+        {
+            if (!nextValue(value))
+                return 0;
+            // stoul accepts a leading '-' and wraps around, so only allow digits
+            size_t pos = 0;
+            try
+            {
+                if (value.empty() || value[0] < '0' || value[0] > '9')
+                    throw std::invalid_argument(value);
+                options.WorkerCount = std::stoul(value, &pos);
+            }
+            catch (...)
+            {
+                pos = 0;
+            }
+
+            if (pos == 0 || pos != value.size())
+            {
+                fprintf(stderr, "Error: invalid thread count \"%s\".\n", value.c_str());
+                return 0;
+            }
+
+            if (options.WorkerCount > MaxWorkerCount)
+            {
+                fprintf(stderr, "Warning: thread count %s is too high, using %zu.\n", value.c_str(), MaxWorkerCount);
+                options.WorkerCount = MaxWorkerCount;
+            }
+        }
+        else if (arg == "--image-format")
+        {
+            if (!nextValue(value))
+                return 0;
+            if (value == "png")
+                options.ImageFormat = ImageExportFormat::PNG;
+            else if (value == "dds")
+                options.ImageFormat = ImageExportFormat::DDS;
+            else
+            {
+                fprintf(stderr, "Error: unknown image format \"%s\".\n", value.c_str());
+                return 0;
+            }
+        }
+        else if (arg == "--model-format")
+        {
+            if (!nextValue(value))
+                return 0;
+            if (value == "obj")
+                options.ModelFormat = ModelExportFormat::OBJ;
+            else if (value == "glb")
+                options.ModelFormat = ModelExportFormat::GLB;
+            else
+            {
+                fprintf(stderr, "Error: unknown model format \"%s\".\n", value.c_str());
+                return 0;
+            }
+        }
+        else if (arg == "--no-material-decls")
+        {
+            options.WriteMaterialDecls = 0;
+        }
+        else if (arg == "-l" || arg == "--list")
+        {
+            options.ListOnly = 1;
+        }
+        else if (arg == "--no-cache")
+        {
+            options.UseCache = 0;
+        }
+        else if (arg.size() > 1 && arg[0] == '-')
+        {
+            fprintf(stderr, "Error: unknown option \"%s\".\n", arg.c_str());
+            return 0;
+        }
+        else
+        {
+            options.ResourcePaths.push_back(arg);
+        }
+    }
+
+    if (options.ResourcePaths.empty())
+    {
+        fprintf(stderr, "Error: no .resources files given.\n");
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char* argv[])
+{
+    CLIOptions options;
+    if (!parseArguments(argc, argv, options))
+    {
+        fprintf(stderr, "Run samuel-cli --help for usage.\n");
+        return 2;
+    }
+
+    // Paths are matched against "base" and split on '/' by the core
+    for (int i = 0; i < options.ResourcePaths.size(); i++)
+        options.ResourcePaths[i] = fs::absolute(options.ResourcePaths[i]).generic_string();
+
+    GLOBAL_RESOURCES globalResources;
+    SAMUEL SAM;
+    SAM.SetExportWorkerCount(options.WorkerCount);
+    SAM.SetImageExportFormat(options.ImageFormat);
+    SAM.SetModelExportFormat(options.ModelFormat);
+    SAM.SetWriteMaterialDecls(options.WriteMaterialDecls);
+
+    if (!options.UseCache)
+    {
+        SAM.SetIndexCacheDirectory("");
+        DecompressedDataCache::GetSharedCache().SetMaxSize(0);
+    }
+
+    if (!SAM.Init(options.ResourcePaths[0], globalResources))
+        return 1;
+
+    fs::path outputDirectory = fs::absolute(options.OutputDirectory);
+    size_t exportedCount = 0;
+    size_t failedCount = 0;
+    bool hasLoadError = 0;
+
+    for (int i = 0; i < options.ResourcePaths.size(); i++)
+    {
+        if (!SAM.LoadResource(options.ResourcePaths[i]))
+        {
+            hasLoadError = 1;
+            continue;
+        }
+
+        // Same rows the GUI passes for selected table items: name, type, version
+        std::vector<std::vector<std::string>> filesToExport;
+        const std::vector<ResourceEntry>& resourceData = SAM.GetResourceData();
+        for (int j = 0; j < resourceData.size(); j++)
+        {
+            const ResourceEntry& entry = resourceData[j];
+            if (!ExportManager::IsExportSupported(entry) || !isSelected(entry, options))
+                continue;
+
+            if (options.ListOnly)
+            {
+                printf("%s\t%s\t%u\n", entry.Name.c_str(), entry.Type.c_str(), entry.Version);
+                continue;
+            }
+            filesToExport.push_back({ entry.Name, entry.Type, std::to_string(entry.Version) });
+        }
+
+        if (filesToExport.empty())
+            continue;
+
+        fprintf(stderr, "Exporting %zu files from %s\n", filesToExport.size(), options.ResourcePaths[i].c_str());
+        SAM.ExportFiles(outputDirectory, filesToExport);
+        exportedCount += SAM.GetLastExportCount() - SAM.GetLastExportFailureCount();
+        failedCount += SAM.GetLastExportFailureCount();
+    }
+
+    if (!options.ListOnly)
+        fprintf(stderr, "Exported %zu files, %zu failed.\n", exportedCount, failedCount);
+
+    return (hasLoadError || failedCount != 0) ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+namespace HAYDEN
+{
+    // Blocking FIFO with a fixed capacity. Push blocks while full, Pop blocks while empty.
+    template <typename T>
+    class BoundedQueue
+    {
+        public:
+
+            // Returns 0 if the queue was closed
+            bool Push(T item)
+            {
+                std::unique_lock<std::mutex> lock(_Mutex);
+                _NotFull.wait(lock, [this]() { return _Closed || _Items.size() < _Capacity; });
+
+                if (_Closed)
+                    return 0;
+
+                _Items.push_back(std::move(item));
+                lock.unlock();
+                _NotEmpty.notify_one();
+                return 1;
+            }
+
+            // Returns 0 once the queue is closed and empty
+            bool Pop(T& item)
+            {
+                std::unique_lock<std::mutex> lock(_Mutex);
+                _NotEmpty.wait(lock, [this]() { return _Closed || !_Items.empty(); });
+
+                if (_Items.empty())
+                    return 0;
+
+                item = std::move(_Items.front());
+                _Items.pop_front();
+                lock.unlock();
+                _NotFull.notify_one();
+                return 1;
+            }
+
+            // No more items will be pushed. Remaining items can still be popped.
+            void Close()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_Mutex);
+                    _Closed = 1;
+                }
+                _NotEmpty.notify_all();
+                _NotFull.notify_all();
+            }
+
+            BoundedQueue(const size_t capacity) : _Capacity(capacity > 0 ? capacity : 1) {}
+            BoundedQueue(const BoundedQueue&) = delete;
+            BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        private:
+
+            size_t _Capacity;
+            bool _Closed = 0;
+            std::deque<T> _Items;
+            std::mutex _Mutex;
+            std::condition_variable _NotEmpty;
+            std::condition_variable _NotFull;
+    };
+}
@@ -0,0 +1,87 @@
+#include "DecompressedDataCache.h"
+
+namespace HAYDEN
+{
+    size_t DecompressedDataCache::CacheKeyHash::operator()(const CacheKey& key) const
+    {
+        size_t hash = std::hash<std::string>()(key.ArchivePath);
+        hash ^= std::hash<uint64_t>()(key.Offset) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<uint64_t>()(key.Size) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    // Cache shared by all readers
+    DecompressedDataCache& DecompressedDataCache::GetSharedCache()
+    {
+        static DecompressedDataCache sharedCache;
+        return sharedCache;
+    }
+
+    // Returns the cached data for this entry, or NULL if it isn't cached
+    std::shared_ptr<const std::vector<uint8_t>> DecompressedDataCache::Find(const std::string& archivePath, const uint64_t offset, const uint64_t size)
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        if (_MaxSize == 0)
+            return NULL;
+
+        auto it = _EntryIndex.find(CacheKey{ archivePath, offset, size });
+        if (it == _EntryIndex.end())
+        {
+            _MissCount++;
+            return NULL;
+        }
+
+        // Move to the front of the LRU list
+        _Entries.splice(_Entries.begin(), _Entries, it->second);
+        _HitCount++;
+        return it->second->Data;
+    }
+
+    // Adds data for this entry, evicting the least recently used entries to stay within the size limit
+    void DecompressedDataCache::Insert(const std::string& archivePath, const uint64_t offset, const uint64_t size, std::vector<uint8_t> data)
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+
+        // Entries larger than the whole cache would only evict everything else
+        if (data.empty() || data.size() > _MaxSize)
+            return;
+
+        CacheKey key{ archivePath, offset, size };
+        if (_EntryIndex.count(key) != 0)
+            return;
+
+        EvictToSize(_MaxSize - data.size());
+        _CurrentSize += data.size();
+        _Entries.push_front(CacheEntry{ key, std::make_shared<const std::vector<uint8_t>>(std::move(data)) });
+        _EntryIndex[key] = _Entries.begin();
+    }
+
+    // Drops least recently used entries until at most maxSize bytes are cached
+    void DecompressedDataCache::EvictToSize(const size_t maxSize)
+    {
+        while (_CurrentSize > maxSize && !_Entries.empty())
+        {
+            _CurrentSize -= _Entries.back().Data->size();
+            _EntryIndex.erase(_Entries.back().Key);
+            _Entries.pop_back();
+        }
+    }
+
+    // Max total size of cached data in bytes. 0 disables the cache.
+    void DecompressedDataCache::SetMaxSize(const size_t maxSize)
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        _MaxSize = maxSize;
+        EvictToSize(_MaxSize);
+    }
+
+    void DecompressedDataCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        _Entries.clear();
+        _EntryIndex.clear();
+        _CurrentSize = 0;
+        _HitCount = 0;
+        _MissCount = 0;
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+namespace HAYDEN
+{
+    // Size-bounded LRU cache of decompressed .resources entries (BIM/model headers, decls),
+    // keyed on (archive path, offset, size) of the compressed data. Thread-safe.
+    class DecompressedDataCache
+    {
+        public:
+
+            // Returns the cached data for this entry, or NULL if it isn't cached
+            std::shared_ptr<const std::vector<uint8_t>> Find(const std::string& archivePath, const uint64_t offset, const uint64_t size);
+
+            // Adds data for this entry, evicting the least recently used entries to stay within the size limit
+            void Insert(const std::string& archivePath, const uint64_t offset, const uint64_t size, std::vector<uint8_t> data);
+
+            // Max total size of cached data in bytes. 0 disables the cache.
+            void SetMaxSize(const size_t maxSize);
+            size_t GetMaxSize() const { std::lock_guard<std::mutex> lock(_Mutex); return _MaxSize; }
+
+            void Clear();
+
+            // Lookup statistics since the last Clear call
+            uint64_t GetHitCount() const { std::lock_guard<std::mutex> lock(_Mutex); return _HitCount; }
+            uint64_t GetMissCount() const { std::lock_guard<std::mutex> lock(_Mutex); return _MissCount; }
+
+            // Cache shared by all readers
+            static DecompressedDataCache& GetSharedCache();
+
+        private:
+
+            struct CacheKey
+            {
+                std::string ArchivePath;
+                uint64_t Offset = 0;
+                uint64_t Size = 0;
+
+                bool operator==(const CacheKey& other) const { return Offset == other.Offset && Size == other.Size && ArchivePath == other.ArchivePath; }
+            };
+
+            struct CacheKeyHash
+            {
+                size_t operator()(const CacheKey& key) const;
+            };
+
+            struct CacheEntry
+            {
+                CacheKey Key;
+                std::shared_ptr<const std::vector<uint8_t>> Data;
+            };
+
+            mutable std::mutex _Mutex;
+            std::list<CacheEntry> _Entries;             // most recently used first
+            std::unordered_map<CacheKey, std::list<CacheEntry>::iterator, CacheKeyHash> _EntryIndex;
+            size_t _MaxSize = 64 * 1024 * 1024;
+            size_t _CurrentSize = 0;
+            uint64_t _HitCount = 0;
+            uint64_t _MissCount = 0;
+
+            void EvictToSize(const size_t maxSize);
+    };
+}
@@ -14,27 +14,21 @@ namespace HAYDEN
     }
 
     // Locate and extract embedded image data from .streamdb file
-    bool BIMExportTask::LocateFileInStreamDB(const std::vector<StreamDBFile>& streamDBFiles)
+    bool BIMExportTask::LocateFileInStreamDB(const StreamDBResolver& streamDBResolver)
     {
-        for (int i = 0; i < streamDBFiles.size(); i++)
-        {
-            _StreamDBEntry = streamDBFiles[i].LocateStreamDBEntry(_StreamedDataHash, _StreamedDataLength);
-            if (_StreamDBEntry.Offset16 > 0)
-            {
-                _StreamDBNumber = i;
-                _StreamDBFilePath = streamDBFiles[i].FilePath; 
-                return 1;
-            }
-        }
-        return 0;
+        StreamDBLocation location = streamDBResolver.Locate(_StreamedDataHash, _StreamedDataLength);
+        if (!location.IsValid())
+            return 0;
+
+        _StreamDBEntry = location.Entry;
+        _StreamDBNumber = location.FileIndex;
+        _StreamDBFilePath = streamDBResolver.GetFile(location.FileIndex).FilePath;
+        return 1;
     }
 
-    // Main export function for BIM files.
-    // Convert BIM file to PNG format and write to local filesystem. 
-    // Return 1 for success, 0 for failure.
-    bool BIMExportTask::Export(const fs::path exportPath, const std::string resourcePath, const std::vector<StreamDBFile>& streamDBFiles, bool reconstructZ)
+    // Read stage: BIM header from .resources file, and raw image data from .streamdb (or the header itself)
+    bool BIMExportTask::ReadData(const std::string resourcePath, const StreamDBResolver& streamDBResolver)
     {
-        std::vector<uint8_t> rawImageData;
         ResourceFileReader resourceFile(resourcePath);
 
         // Extract BIM header from .resources file and read it
@@ -61,56 +55,106 @@ namespace HAYDEN
         // Convert resourceID to streamFileID
         _StreamedDataHash = resourceFile.CalculateStreamDBIndex(_ResourceID, _ImgMipCount);
 
-        // Locate and extract the BIM image from .streamdb file
-        if (_IsStreamed)
+        // Non-streamed image, can grab image data directly from extracted .resources entry
+        if (!_IsStreamed)
         {
-            // If no match is found, reduce _StreamedDataHash by 1 and search again. 
-            // This is necessary for locating some BIM files (reason for this is unknown)
-            if (!LocateFileInStreamDB(streamDBFiles))
-            {
-                _StreamedDataHash--;
-                if (!LocateFileInStreamDB(streamDBFiles))
-                    return 0; // abort
-            }
+            _ImageData = GetBIMRawImage();
+            return 1;
+        }
 
-            // Extract streaming image data from .streamdb file,.
-            rawImageData = streamDBFiles[_StreamDBNumber].GetEmbeddedFile(_StreamDBFilePath, _StreamDBEntry);
-                
-            // Decompress the streamed image data if needed (almost always).
-            if (_StreamDBEntry.CompressedSize != _StreamedDataLengthDecompressed)
+        // If no match is found, reduce _StreamedDataHash by 1 and search again. 
+        // This is necessary for locating some BIM files (reason for this is unknown)
+        if (!LocateFileInStreamDB(streamDBResolver))
+        {
+            _StreamedDataHash--;
+            if (!LocateFileInStreamDB(streamDBResolver))
+                return 0; // abort
+        }
+
+        // Extract streaming image data from .streamdb file,.
+        _ImageData = streamDBResolver.GetFile(_StreamDBNumber).GetEmbeddedFile(_StreamDBFilePath, _StreamDBEntry);
+        return 1;
+    }
+
+    // Decompress stage
+    bool BIMExportTask::DecompressData()
+    {
+        // Decompress the streamed image data if needed (almost always).
+        if (_IsStreamed && _StreamDBEntry.CompressedSize != _StreamedDataLengthDecompressed)
+        {
+            // Decompress straight into the DDS file buffer, leaving room for the header written in ConvertData.
+            // The header size only depends on the image type.
+            size_t headerSize = DDSHeaderBuilder(_ImgPixelWidth, _ImgPixelHeight, _StreamedDataLengthDecompressed, static_cast<ImageType>(_ImgType)).ConvertToByteVector().size();
+            std::vector<uint8_t> ddsFile(headerSize + _StreamedDataLengthDecompressed + SAFE_SPACE);
+            uint64_t outbytes = oodleDecompress(_ImageData.data(), _ImageData.size(), ddsFile.data() + headerSize, _StreamedDataLengthDecompressed);
+
+            if (outbytes == 0)
             {
-                rawImageData = oodleDecompress(rawImageData, _StreamedDataLengthDecompressed);
-                if (rawImageData.empty())
-                {
-                    fprintf(stderr, "Error: Failed to decompress: %s \n", _FileName.c_str());
-                    return 0;
-                }
+                fprintf(stderr, "Error: Failed to decompress: %s \n", _FileName.c_str());
+                return 0;
             }
+
+            ddsFile.resize(headerSize + outbytes);
+            _ImageData = std::move(ddsFile);
+            _ImageDataOffset = headerSize;
+        }
+        return 1;
+    }
+
+    // Convert stage: DDS -> PNG, or DDS as-is
+    bool BIMExportTask::ConvertData(bool reconstructZ, const ImageExportFormat imageFormat)
+    {
+        // Construct a DDS file header from serialized BIM data
+        DDSHeaderBuilder ddsBuilder(_ImgPixelWidth, _ImgPixelHeight, _StreamedDataLengthDecompressed, static_cast<ImageType>(_ImgType), imageFormat == ImageExportFormat::DDS);
+        std::vector<uint8_t> ddsHeader = ddsBuilder.ConvertToByteVector();
+        std::vector<uint8_t> ddsFile;
+
+        // Merge header and data into one byte vector.
+        // Decompressed data already has space reserved for the header.
+        if (_ImageDataOffset == ddsHeader.size())
+        {
+            std::memcpy(_ImageData.data(), ddsHeader.data(), ddsHeader.size());
+            ddsFile = std::move(_ImageData);
         }
         else
         {
-            // Non-streamed image, can grab image data directly from extracted .resources entry
-            rawImageData = GetBIMRawImage();
+            ddsFile = std::move(ddsHeader);
+            ddsFile.insert(ddsFile.end(), _ImageData.begin() + _ImageDataOffset, _ImageData.end());
         }
+        _ImageData.clear();
+        _ImageData.shrink_to_fit();
+        _ImageDataOffset = 0;
 
-        // Construct a DDS file header from serialized BIM data
-        DDSHeaderBuilder ddsBuilder(_ImgPixelWidth, _ImgPixelHeight, _StreamedDataLengthDecompressed, static_cast<ImageType>(_ImgType));
-        std::vector<uint8_t> ddsFile = ddsBuilder.ConvertToByteVector();
-
-        // Merge header and data into one byte vector
-        ddsFile.insert(ddsFile.end(), rawImageData.begin(), rawImageData.end());
+        // No conversion needed
+        if (imageFormat == ImageExportFormat::DDS)
+        {
+            _OutputData = std::move(ddsFile);
+            return 1;
+        }
 
         // Convert DDS file to PNG format
         PNGFile pngFile;
-        std::vector<uint8_t> pngData = pngFile.ConvertDDStoPNG(ddsFile, reconstructZ);
+        _OutputData = pngFile.ConvertDDStoPNG(ddsFile, reconstructZ);
 
-        if (pngData.empty())
+        if (_OutputData.empty())
         {
             fprintf(stderr, "ERROR: Failed to read from given file. \n");
             return 0;
         }
+        return 1;
+    }
 
-        // Write file to local filesystem
-        return writeToFilesystem(pngData, exportPath);
+    // Write stage
+    bool BIMExportTask::WriteData(const fs::path exportPath)
+    {
+        return writeToFilesystem(_OutputData, exportPath);
+    }
+
+    // Main export function for BIM files.
+    // Convert BIM file to PNG (or DDS) format and write to local filesystem. 
+    // Return 1 for success, 0 for failure.
+    bool BIMExportTask::Export(const fs::path exportPath, const std::string resourcePath, const StreamDBResolver& streamDBResolver, bool reconstructZ, const ImageExportFormat imageFormat)
+    {
+        return ReadData(resourcePath, streamDBResolver) && DecompressData() && ConvertData(reconstructZ, imageFormat) && WriteData(exportPath);
     }
 }
\ No newline at end of file
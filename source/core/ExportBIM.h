@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <cstring>
 #include <vector>
 #include <filesystem>
 
@@ -11,15 +12,22 @@
 #include "idFileTypes/ResourceFile.h"
 #include "idFileTypes/StreamDBFile.h"
 
-#include "ExportManager.h"
 #include "Oodle.h"
 #include "ResourceFileReader.h"
+#include "StreamDBResolver.h"
 #include "Utilities.h"
 
 namespace fs = std::filesystem;
 
 namespace HAYDEN
 {
+    // File format for exported textures
+    enum class ImageExportFormat
+    {
+        PNG = 0,
+        DDS = 1             // DDS header + image data as stored in the game, no conversion
+    };
+
     class BIMExportTask
     {
 	public:
@@ -29,10 +37,16 @@ namespace HAYDEN
             std::vector<uint8_t> GetBIMRawImage() { return _BIM.RawImageData; }           
 
             // Helper function for locating streamed file data in *.streamdb
-            bool LocateFileInStreamDB(const std::vector<StreamDBFile>& streamDBFiles);            
+            bool LocateFileInStreamDB(const StreamDBResolver& streamDBResolver);
 
-            // Main Export function
-            bool Export(const fs::path exportPath, const std::string resourcePath, const std::vector<StreamDBFile>& streamDBFiles, bool reconstructZ = false);
+            // Export stages, in order. Each returns 0 on failure.
+            bool ReadData(const std::string resourcePath, const StreamDBResolver& streamDBResolver);
+            bool DecompressData();
+            bool ConvertData(bool reconstructZ = false, const ImageExportFormat imageFormat = ImageExportFormat::PNG);
+            bool WriteData(const fs::path exportPath);
+
+            // Main Export function, runs all stages
+            bool Export(const fs::path exportPath, const std::string resourcePath, const StreamDBResolver& streamDBResolver, bool reconstructZ = false, const ImageExportFormat imageFormat = ImageExportFormat::PNG);
 
             // Constructor
             BIMExportTask(const ResourceEntry resourceEntry);
@@ -54,7 +68,7 @@ namespace HAYDEN
             uint64_t _StreamedDataLength = 0;
             uint64_t _StreamedDataLengthDecompressed = 0;
             int32_t _StreamCompressionType = 0;
-            int32_t _StreamDBNumber = -1;                            // index into std::vector<StreamDBFile>& streamDBFiles
+            int32_t _StreamDBNumber = -1;                            // index into StreamDBResolver files
             bool _IsStreamed = 1;
 
             // Matching StreamDBEntry for the BIM data
@@ -68,5 +82,11 @@ namespace HAYDEN
 
             // Serialized BIM header extracted *.resources file
             BIM _BIM;
+
+            // Image data between stages (raw -> decompressed), and the converted output file.
+            // Decompressed data starts at _ImageDataOffset, the bytes before it are reserved for the DDS header.
+            std::vector<uint8_t> _ImageData;
+            size_t _ImageDataOffset = 0;
+            std::vector<uint8_t> _OutputData;
     };
 }
\ No newline at end of file
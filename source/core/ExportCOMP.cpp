@@ -11,28 +11,54 @@ namespace HAYDEN
         return;
     }
 
-    bool COMPExportTask::Export(const fs::path exportPath, const std::string resourcePath)
+    // Read stage: comp file from .resources file
+    bool COMPExportTask::ReadData(const std::string resourcePath)
     {
         ResourceFileReader resourceFile(resourcePath);
-        std::vector<uint8_t> compFile = resourceFile.GetEmbeddedFileHeader(resourcePath, _ResourceDataOffset, _ResourceDataLength, _ResourceDataLengthDecompressed);
+        return resourceFile.ReadEmbeddedFile(resourcePath, _ResourceDataOffset, _ResourceDataLength, _FileData);
+    }
+
+    // Decompress stage
+    bool COMPExportTask::DecompressData()
+    {
+        // .resources entry compression (usually none)
+        if (_FileData.size() != _ResourceDataLengthDecompressed)
+            _FileData = oodleDecompress(_FileData, _ResourceDataLengthDecompressed);
 
-        if (compFile.empty())
+        if (_FileData.size() < 16)
             return 0;
 
-        // Read compressed and decompressed size from comp file header
-        int decompressedSize = *(int*)(compFile.data() + 0);
-        int compressedSize = *(int*)(compFile.data() + 8);
+        // Read decompressed size from comp file header
+        int decompressedSize = *(int*)(_FileData.data() + 0);
+        if (decompressedSize <= 0)
+        {
+            fprintf(stderr, "Error: Invalid decompressed size in comp file header: %s \n", _FileName.c_str());
+            return 0;
+        }
 
-        // Remove header and decompress remaining data
-        compFile.erase(compFile.begin(), compFile.begin() + 16);
-        compFile = oodleDecompress(compFile, decompressedSize);
+        // Decompress the data following the header
+        std::vector<uint8_t> decompressedData(decompressedSize + SAFE_SPACE);
+        uint64_t outbytes = oodleDecompress(_FileData.data() + 16, _FileData.size() - 16, decompressedData.data(), decompressedSize);
 
-        if (compFile.empty())
+        if (outbytes == 0)
         {
             fprintf(stderr, "Error: Failed to decompress: %s \n", _FileName.c_str());
             return 0;
         }
 
-        return writeToFilesystem(compFile, exportPath);
+        decompressedData.resize(outbytes);
+        _FileData = std::move(decompressedData);
+        return 1;
+    }
+
+    // Write stage
+    bool COMPExportTask::WriteData(const fs::path exportPath)
+    {
+        return writeToFilesystem(_FileData, exportPath);
+    }
+
+    bool COMPExportTask::Export(const fs::path exportPath, const std::string resourcePath)
+    {
+        return ReadData(resourcePath) && DecompressData() && WriteData(exportPath);
     }
-}
\ No newline at end of file
+}
@@ -18,6 +18,12 @@ namespace HAYDEN
     {
         public:
 
+            // Export stages, in order. Each returns 0 on failure.
+            bool ReadData(const std::string resourcePath);
+            bool DecompressData();
+            bool WriteData(const fs::path exportPath);
+
+            // Runs all stages
             bool Export(const fs::path exportPath, const std::string resourcePath);
             COMPExportTask(const ResourceEntry resourceEntry);
 
@@ -27,5 +33,6 @@ namespace HAYDEN
             uint64_t _ResourceDataOffset = 0;
             uint64_t _ResourceDataLength = 0;
             uint64_t _ResourceDataLengthDecompressed = 0;
+            std::vector<uint8_t> _FileData;
     };
 }
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "ExportCache.h"
+
+namespace HAYDEN
+{
+    // Export an entry to outputFile with exportFunction the first time it is requested.
+    // Later requests hardlink (or copy, if linking fails) the first output. Return 1 on success.
+    bool ExportCache::ExportOnce(const ResourceEntry* resourceEntry, const fs::path& outputFile, const std::function<bool()>& exportFunction)
+    {
+        std::shared_ptr<CachedExport> cachedExport;
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            std::shared_ptr<CachedExport>& slot = _Exports[resourceEntry];
+            if (slot == NULL)
+                slot = std::make_shared<CachedExport>();
+            cachedExport = slot;
+        }
+
+        // Held while exporting, so other requests for this entry wait for the result
+        std::lock_guard<std::mutex> lock(cachedExport->Mutex);
+
+        if (!cachedExport->Done)
+        {
+            // outputFile may be a hardlink made for another entry with the same file name.
+            // Writing through it would change that entry's output too, so start from a new file.
+            std::error_code error;
+            fs::remove(outputFile, error);
+
+            cachedExport->Result = exportFunction();
+            cachedExport->OutputFile = outputFile;
+            cachedExport->Done = 1;
+            return cachedExport->Result;
+        }
+
+        // Failed before, don't try again
+        if (!cachedExport->Result)
+            return 0;
+
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _ReuseCount++;
+        }
+
+        if (cachedExport->OutputFile == outputFile)
+            return 1;
+
+        return LinkOrCopy(cachedExport->OutputFile, outputFile);
+    }
+
+    // Load an entry's data with loadFunction the first time it is requested. Returns NULL on failure (empty data).
+    std::shared_ptr<const std::vector<uint8_t>> ExportCache::LoadOnce(const ResourceEntry* resourceEntry, const std::function<std::vector<uint8_t>()>& loadFunction)
+    {
+        std::shared_ptr<CachedData> cachedData;
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            std::shared_ptr<CachedData>& slot = _Data[resourceEntry];
+            if (slot == NULL)
+                slot = std::make_shared<CachedData>();
+            cachedData = slot;
+        }
+
+        std::lock_guard<std::mutex> lock(cachedData->Mutex);
+
+        if (!cachedData->Done)
+        {
+            std::vector<uint8_t> data = loadFunction();
+            if (!data.empty())
+                cachedData->Data = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+            cachedData->Done = 1;
+            return cachedData->Data;
+        }
+
+        if (cachedData->Data != NULL)
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _ReuseCount++;
+        }
+        return cachedData->Data;
+    }
+
+    void ExportCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        _Exports.clear();
+        _Data.clear();
+        _ReuseCount = 0;
+    }
+
+    // Hardlink sourceFile to outputFile, replacing outputFile if it exists. Falls back to copying (e.g. across drives, FAT32).
+    bool ExportCache::LinkOrCopy(const fs::path& sourceFile, const fs::path& outputFile)
+    {
+        fs::path folderPath = outputFile;
+        folderPath.remove_filename();
+
+        if (!fs::exists(folderPath))
+        {
+            if (!mkpath(folderPath))
+            {
+                fprintf(stderr, "Error: Failed to create directories for file: %s \n", outputFile.string().c_str());
+                return 0;
+            }
+        }
+
+        std::error_code error;
+        fs::remove(outputFile, error);
+
+        fs::create_hard_link(sourceFile, outputFile, error);
+        if (!error)
+            return 1;
+
+        fs::copy_file(sourceFile, outputFile, fs::copy_options::overwrite_existing, error);
+        if (!error)
+            return 1;
+
+        fprintf(stderr, "Error: Failed to copy %s to %s \n", sourceFile.string().c_str(), outputFile.string().c_str());
+        return 0;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <filesystem>
+#include <unordered_map>
+
+#include "ResourceFileReader.h"
+#include "Utilities.h"
+
+namespace fs = std::filesystem;
+
+namespace HAYDEN
+{
+    // Batch-scoped cache for model dependencies (material2 decls, BIM textures) shared by several models.
+    // Keyed on the resolved ResourceEntry, so entries must outlive the cache (or the next Clear call).
+    // Thread-safe. Concurrent requests for the same entry wait for the first one to finish.
+    class ExportCache
+    {
+        public:
+
+            // Export an entry to outputFile with exportFunction the first time it is requested.
+            // Later requests hardlink (or copy, if linking fails) the first output. Return 1 on success.
+            bool ExportOnce(const ResourceEntry* resourceEntry, const fs::path& outputFile, const std::function<bool()>& exportFunction);
+
+            // Load an entry's data with loadFunction the first time it is requested. Returns NULL on failure (empty data).
+            std::shared_ptr<const std::vector<uint8_t>> LoadOnce(const ResourceEntry* resourceEntry, const std::function<std::vector<uint8_t>()>& loadFunction);
+
+            void Clear();
+
+            // Number of exports and loads served from the cache
+            size_t GetReuseCount() const { std::lock_guard<std::mutex> lock(_Mutex); return _ReuseCount; }
+
+        private:
+
+            struct CachedExport
+            {
+                std::mutex Mutex;
+                bool Done = 0;
+                bool Result = 0;
+                fs::path OutputFile;
+            };
+
+            struct CachedData
+            {
+                std::mutex Mutex;
+                bool Done = 0;
+                std::shared_ptr<const std::vector<uint8_t>> Data;
+            };
+
+            mutable std::mutex _Mutex;
+            std::unordered_map<const ResourceEntry*, std::shared_ptr<CachedExport>> _Exports;
+            std::unordered_map<const ResourceEntry*, std::shared_ptr<CachedData>> _Data;
+            size_t _ReuseCount = 0;
+
+            static bool LinkOrCopy(const fs::path& sourceFile, const fs::path& outputFile);
+    };
+}
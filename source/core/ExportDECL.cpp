@@ -11,14 +11,43 @@ namespace HAYDEN
         return;
     }
 
-    bool DECLExportTask::Export(const fs::path exportPath, const std::string resourcePath)
+    // Read stage: raw .decl data from .resources file
+    bool DECLExportTask::ReadData(const std::string resourcePath)
     {
+        _ResourcePath = resourcePath;
+
+        // Decompressed before, DecompressData has nothing left to do
+        auto cachedData = DecompressedDataCache::GetSharedCache().Find(resourcePath, _ResourceDataOffset, _ResourceDataLength);
+        if (cachedData != NULL)
+        {
+            _FileData = *cachedData;
+            return 1;
+        }
+
         ResourceFileReader resourceFileReader(resourcePath);
-        std::vector<uint8_t> fileData = resourceFileReader.GetEmbeddedFileHeader(resourcePath, _ResourceDataOffset, _ResourceDataLength, _ResourceDataLengthDecompressed);
+        return resourceFileReader.ReadEmbeddedFile(resourcePath, _ResourceDataOffset, _ResourceDataLength, _FileData);
+    }
+
+    // Decompress stage
+    bool DECLExportTask::DecompressData()
+    {
+        if (_FileData.size() != _ResourceDataLengthDecompressed)
+        {
+            _FileData = oodleDecompress(_FileData, _ResourceDataLengthDecompressed);
+            DecompressedDataCache::GetSharedCache().Insert(_ResourcePath, _ResourceDataOffset, _ResourceDataLength, _FileData);
+        }
 
-        if (fileData.empty())
-            return 0;
+        return !_FileData.empty();
+    }
+
+    // Write stage
+    bool DECLExportTask::WriteData(const fs::path exportPath)
+    {
+        return writeToFilesystem(_FileData, exportPath);
+    }
 
-        return writeToFilesystem(fileData, exportPath);
+    bool DECLExportTask::Export(const fs::path exportPath, const std::string resourcePath)
+    {
+        return ReadData(resourcePath) && DecompressData() && WriteData(exportPath);
     }
-}
\ No newline at end of file
+}
@@ -6,6 +6,7 @@
 
 #include "idFileTypes/ResourceFile.h"
 
+#include "Oodle.h"
 #include "ResourceFileReader.h"
 #include "Utilities.h"
 
@@ -17,14 +18,25 @@ namespace HAYDEN
     {
         public:
 
+            // Export stages, in order. Each returns 0 on failure.
+            bool ReadData(const std::string resourcePath);
+            bool DecompressData();
+            bool WriteData(const fs::path exportPath);
+
+            // Decompressed .decl data, valid after DecompressData()
+            const std::vector<uint8_t>& GetFileData() const { return _FileData; }
+
+            // Runs all stages
             bool Export(const fs::path exportPath, const std::string resourcePath);
             DECLExportTask(const ResourceEntry resourceEntry);
 
         private:
 
             std::string _FileName;        
+            std::string _ResourcePath;
             uint64_t _ResourceDataOffset = 0;
             uint64_t _ResourceDataLength = 0;
             uint64_t _ResourceDataLengthDecompressed = 0;
+            std::vector<uint8_t> _FileData;
     };
 }
\ No newline at end of file
@@ -34,7 +34,7 @@ namespace HAYDEN
                 outputDirectory = outputDirectory / resourceFolder;
                 break;
             case ExportType::BIM:
-                filePath = filePath + ".png";
+                filePath = filePath + (_ImageFormat == ImageExportFormat::DDS ? ".dds" : ".png");
                 outputDirectory = outputDirectory / resourceFolder;
                 break;
             case ExportType::LWO:
@@ -48,8 +48,34 @@ namespace HAYDEN
         return outputDirectory;
     }
 
+    // Whether an entry is a file type and variant that can be exported
+    bool ExportManager::IsExportSupported(const ResourceEntry& entry)
+    {
+        switch (entry.Version)
+        {
+            case 0:
+                // Only .decl/.entities files stored as rs_streamfile
+                return entry.Type == "rs_streamfile";
+            case 1:
+                return entry.Type == "compfile";
+            case 21:
+                // Light probes are not supported
+                return entry.Name.rfind("/lightprobes/") == -1;
+            case 31:
+                // Alembic (.abc) md6 are not supported
+                return entry.Name.rfind(".abc") == -1;
+            case 67:
+                // World geometry and .bmodel lwo are not supported
+                if (entry.Name.rfind("world_") != -1 && entry.Name.find("maps/game") != -1)
+                    return 0;
+                return entry.Name.rfind(".bmodel") == -1;
+            default:
+                return 0;
+        }
+    }
+
     // Main file export function
-    bool ExportManager::ExportFiles(GLOBAL_RESOURCES* globalResources, std::vector<ResourceEntry>& resourceData, const std::string resourcePath, const std::vector<StreamDBFile>& streamDBFiles, const fs::path outputDirectory, const std::vector<std::vector<std::string>> filesToExport)
+    bool ExportManager::ExportFiles(const ResourceIndex& resourceIndex, std::vector<ResourceEntry>& resourceData, const std::string resourcePath, const StreamDBResolver& streamDBResolver, const fs::path outputDirectory, const std::vector<std::vector<std::string>> filesToExport)
     {
         // Abort if this function was called without any files selected for extraction.
         if (filesToExport.size() == 0)
@@ -58,6 +84,9 @@ namespace HAYDEN
         // Determine output directory
         std::string resourceFolder = GetResourceFolder(resourcePath);
 
+        // Dependencies are only shared within this batch
+        _ExportCache.Clear();
+
         // Create seperate export lists for each type of file
         // Some files have the same names but different versions (types), so we need to keep this separate
         for (int i = 0; i < filesToExport.size(); i++)
@@ -67,19 +96,19 @@ namespace HAYDEN
             switch (fileType)
             {
                 case 0:
-                    _DECLFileNames.push_back(filesToExport[i][0]);
+                    _DECLFileNames.insert(filesToExport[i][0]);
                     break;
                 case 1:
-                    _COMPFileNames.push_back(filesToExport[i][0]);
+                    _COMPFileNames.insert(filesToExport[i][0]);
                     break;
                 case 21:
-                    _BIMFileNames.push_back(filesToExport[i][0]);
+                    _BIMFileNames.insert(filesToExport[i][0]);
                     break;
                 case 31:
-                    _MD6FileNames.push_back(filesToExport[i][0]);
+                    _MD6FileNames.insert(filesToExport[i][0]);
                     break;
                 case 67:
-                    _LWOFileNames.push_back(filesToExport[i][0]);
+                    _LWOFileNames.insert(filesToExport[i][0]);
                     break;
                 default:
                     break;
@@ -90,7 +119,7 @@ namespace HAYDEN
         for (uint64_t i = 0; i < resourceData.size(); i++)
         {
             ExportTask task;
-            ResourceEntry thisEntry = resourceData[i];
+            const ResourceEntry& thisEntry = resourceData[i];
 
             // Skip this entry if it contains no data to extract. 
             // This can happen with certain files that have been removed from the game.
@@ -102,27 +131,27 @@ namespace HAYDEN
             {
                 case 0:
                     task.Type = ExportType::DECL;
-                    if (std::find(_DECLFileNames.begin(), _DECLFileNames.end(), thisEntry.Name) == _DECLFileNames.end())
+                    if (_DECLFileNames.count(thisEntry.Name) == 0)
                         continue;
                     break;
                 case 1:
                     task.Type = ExportType::COMP;
-                    if (std::find(_COMPFileNames.begin(), _COMPFileNames.end(), thisEntry.Name) == _COMPFileNames.end())
+                    if (_COMPFileNames.count(thisEntry.Name) == 0)
                         continue;
                     break;
                 case 21:
                     task.Type = ExportType::BIM;
-                    if (std::find(_BIMFileNames.begin(), _BIMFileNames.end(), thisEntry.Name) == _BIMFileNames.end())
+                    if (_BIMFileNames.count(thisEntry.Name) == 0)
                         continue;
                     break;
                 case 31:
                     task.Type = ExportType::MD6;
-                    if (std::find(_MD6FileNames.begin(), _MD6FileNames.end(), thisEntry.Name) == _MD6FileNames.end())
+                    if (_MD6FileNames.count(thisEntry.Name) == 0)
                         continue;
                     break;
                 case 67:
                     task.Type = ExportType::LWO;
-                    if (std::find(_LWOFileNames.begin(), _LWOFileNames.end(), thisEntry.Name) == _LWOFileNames.end())
+                    if (_LWOFileNames.count(thisEntry.Name) == 0)
                         continue;
                     break;
                 default:
@@ -135,44 +164,163 @@ namespace HAYDEN
             _ExportJobQueue.push_back(task);
         }
 
+        // Tasks writing to the same path (e.g. models sharing a name) must not run at the same time,
+        // so they are grouped by export path. Each group moves through the pipeline as one item,
+        // its tasks run serially within every stage.
+        std::vector<std::vector<size_t>> taskGroups;
+        std::unordered_map<std::string, size_t> taskGroupIndexes;
+        for (size_t i = 0; i < _ExportJobQueue.size(); i++)
+        {
+            auto groupIndex = taskGroupIndexes.emplace(_ExportJobQueue[i].ExportPath.string(), taskGroups.size());
+            if (groupIndex.second)
+                taskGroups.emplace_back();
+            taskGroups[groupIndex.first->second].push_back(i);
+        }
+
+        // Runs one stage for every task in a group. The group is dropped once all of its tasks failed.
+        std::vector<ExportJob> exportJobs(_ExportJobQueue.size());
+        auto runStage = [&](const ExportStage stage, const size_t groupIndex) {
+            bool anyPassed = 0;
+            for (size_t i = 0; i < taskGroups[groupIndex].size(); i++)
+            {
+                size_t taskIndex = taskGroups[groupIndex][i];
+                ExportTask& task = _ExportJobQueue[taskIndex];
+                ExportJob& job = exportJobs[taskIndex];
+                if (job.Failed)
+                    continue;
+
+                try
+                {
+                    job.Failed = !RunExportStage(stage, task, job, resourceIndex, resourcePath, streamDBResolver);
+                }
+                catch (...)
+                {
+                    fprintf(stderr, "Error: Failed to export %s \n", task.Entry.Name.c_str());
+                    job.Failed = 1;
+                }
+
+                // Exporter is no longer needed once written
+                if (stage == ExportStage::Write)
+                {
+                    task.Result = !job.Failed;
+                    job = ExportJob();
+                }
+                anyPassed |= !job.Failed;
+            }
+            return anyPassed;
+        };
+
         // Iterate through _ExportJobQueue and complete the file export
-        for (int i = 0; i < _ExportJobQueue.size(); i++)
+        ExportPipeline exportPipeline;
+        exportPipeline.AddStage("read", GetStageWorkerCount(ExportStage::Read), [&](size_t i) { return runStage(ExportStage::Read, i); });
+        exportPipeline.AddStage("decompress", GetStageWorkerCount(ExportStage::Decompress), [&](size_t i) { return runStage(ExportStage::Decompress, i); });
+        exportPipeline.AddStage("convert", GetStageWorkerCount(ExportStage::Convert), [&](size_t i) { return runStage(ExportStage::Convert, i); });
+        exportPipeline.AddStage("write", GetStageWorkerCount(ExportStage::Write), [&](size_t i) { return runStage(ExportStage::Write, i); });
+        exportPipeline.Run(taskGroups.size());
+
+        return 1;
+    }
+
+    // Default worker counts: disk-bound stages get 2 threads, CPU-bound stages get _WorkerCount
+    size_t ExportManager::GetStageWorkerCount(const ExportStage stage) const
+    {
+        if (_StageWorkerCounts[(int)stage] != 0)
+            return _StageWorkerCounts[(int)stage];
+
+        size_t cpuWorkerCount = _WorkerCount != 0 ? _WorkerCount : ThreadPool::GetDefaultThreadCount();
+        switch (stage)
+        {
+            case ExportStage::Read:
+            case ExportStage::Write:
+                return std::min<size_t>(cpuWorkerCount, 2);
+            default:
+                return cpuWorkerCount;
+        }
+    }
+
+    // Runs one stage of an export task, creating the exporter on the read stage. Return 1 on success.
+    bool ExportManager::RunExportStage(const ExportStage stage, const ExportTask& task, ExportJob& job, const ResourceIndex& resourceIndex, const std::string& resourcePath, const StreamDBResolver& streamDBResolver)
+    {
+        switch (task.Type)
         {
-            switch (_ExportJobQueue[i].Type)
+            case ExportType::BIM:
             {
-                case ExportType::BIM:
+                if (stage == ExportStage::Read)
+                    job.BIMTask = std::make_unique<BIMExportTask>(task.Entry);
+
+                switch (stage)
                 {
-                    BIMExportTask bimExportTask(_ExportJobQueue[i].Entry);
-                    _ExportJobQueue[i].Result = bimExportTask.Export(_ExportJobQueue[i].ExportPath, resourcePath, streamDBFiles, true);
-                    break;
+                    case ExportStage::Read:
+                        return job.BIMTask->ReadData(resourcePath, streamDBResolver);
+                    case ExportStage::Decompress:
+                        return job.BIMTask->DecompressData();
+                    case ExportStage::Convert:
+                        return job.BIMTask->ConvertData(true, _ImageFormat);
+                    case ExportStage::Write:
+                        return job.BIMTask->WriteData(task.ExportPath);
                 }
-                case ExportType::COMP:
+                break;
+            }
+            case ExportType::COMP:
+            {
+                if (stage == ExportStage::Read)
+                    job.COMPTask = std::make_unique<COMPExportTask>(task.Entry);
+
+                switch (stage)
                 {
-                    COMPExportTask compExportTask(_ExportJobQueue[i].Entry);
-                    _ExportJobQueue[i].Result = compExportTask.Export(_ExportJobQueue[i].ExportPath, resourcePath);
-                    break;
+                    case ExportStage::Read:
+                        return job.COMPTask->ReadData(resourcePath);
+                    case ExportStage::Decompress:
+                        return job.COMPTask->DecompressData();
+                    case ExportStage::Convert:
+                        return 1;
+                    case ExportStage::Write:
+                        return job.COMPTask->WriteData(task.ExportPath);
                 }
-                case ExportType::DECL:
+                break;
+            }
+            case ExportType::DECL:
+            {
+                if (stage == ExportStage::Read)
+                    job.DECLTask = std::make_unique<DECLExportTask>(task.Entry);
+
+                switch (stage)
                 {
-                    DECLExportTask declExportTask(_ExportJobQueue[i].Entry);
-                    _ExportJobQueue[i].Result = declExportTask.Export(_ExportJobQueue[i].ExportPath, resourcePath);
-                    break;
+                    case ExportStage::Read:
+                        return job.DECLTask->ReadData(resourcePath);
+                    case ExportStage::Decompress:
+                        return job.DECLTask->DecompressData();
+                    case ExportStage::Convert:
+                        return 1;
+                    case ExportStage::Write:
+                        return job.DECLTask->WriteData(task.ExportPath);
                 }
-                case ExportType::MD6:
+                break;
+            }
+            case ExportType::MD6:
+            case ExportType::LWO:
+            {
+                if (stage == ExportStage::Read)
                 {
-                    ModelExportTask modelExportTask(_ExportJobQueue[i].Entry);
-                    modelExportTask.Export(_ExportJobQueue[i].ExportPath, resourcePath, streamDBFiles, resourceData, globalResources, 31);
-                    break;
+                    job.ModelTask = std::make_unique<ModelExportTask>(task.Entry);
+                    job.ModelTask->WriteMaterialDecls = _WriteMaterialDecls;
+                    job.ModelTask->SharedExportCache = &_ExportCache;
                 }
-                case ExportType::LWO:
+
+                switch (stage)
                 {
-                    ModelExportTask modelExportTask(_ExportJobQueue[i].Entry);
-                    modelExportTask.Export(_ExportJobQueue[i].ExportPath, resourcePath, streamDBFiles, resourceData, globalResources, 67);
-                    break;
+                    case ExportStage::Read:
+                        return job.ModelTask->ReadData(task.ExportPath, resourcePath, streamDBResolver, (int)task.Type);
+                    case ExportStage::Decompress:
+                        return job.ModelTask->DecompressData();
+                    case ExportStage::Convert:
+                        return job.ModelTask->ConvertData(streamDBResolver, resourceIndex);
+                    case ExportStage::Write:
+                        return job.ModelTask->WriteData(_ModelFormat);
                 }
+                break;
             }
         }
-
-        return 1;
+        return 0;
     }
 }
\ No newline at end of file
@@ -2,13 +2,21 @@
 
 #include <string>
 #include <vector>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <filesystem>
 
 #include "Common.h"
 #include "ExportBIM.h"
+#include "ExportCache.h"
 #include "ExportCOMP.h"
 #include "ExportDECL.h"
 #include "ExportModel.h"
+#include "StreamDBResolver.h"
+#include "ExportPipeline.h"
+#include "ResourceIndex.h"
+#include "ThreadPool.h"
 
 namespace fs = std::filesystem;
 
@@ -23,6 +31,15 @@ namespace HAYDEN
         LWO = 67
     };
 
+    // Stages of the export pipeline, in order
+    enum class ExportStage
+    {
+        Read = 0,
+        Decompress = 1,
+        Convert = 2,
+        Write = 3
+    };
+
     class ExportTask
     {
         public:
@@ -32,19 +49,59 @@ namespace HAYDEN
             ResourceEntry Entry;
     };
 
+    // Exporter state for one ExportTask while it moves through the pipeline stages
+    struct ExportJob
+    {
+        bool Failed = 0;
+        std::unique_ptr<BIMExportTask> BIMTask;
+        std::unique_ptr<COMPExportTask> COMPTask;
+        std::unique_ptr<DECLExportTask> DECLTask;
+        std::unique_ptr<ModelExportTask> ModelTask;
+    };
+
     class ExportManager
     {
         public:
             std::string GetResourceFolder(const std::string resourcePath);
             fs::path BuildOutputPath(std::string filePath, fs::path outputDirectory, const ExportType exportType, const std::string resourceFolder);
-            bool ExportFiles(GLOBAL_RESOURCES* globalResources, std::vector<ResourceEntry>& resourceData, const std::string resourcePath, const std::vector<StreamDBFile>& streamDBFiles, const fs::path outputDirectory, const std::vector<std::vector<std::string>> filesToExport);
+            bool ExportFiles(const ResourceIndex& resourceIndex, std::vector<ResourceEntry>& resourceData, const std::string resourcePath, const StreamDBResolver& streamDBResolver, const fs::path outputDirectory, const std::vector<std::vector<std::string>> filesToExport);
+
+            // Number of threads used by the CPU-bound stages (decompress, convert). 0 = one per hardware thread.
+            void SetWorkerCount(const size_t workerCount) { _WorkerCount = workerCount; }
+
+            // Number of threads used by a single stage, overrides the defaults. 0 = use default.
+            void SetStageWorkerCount(const ExportStage stage, const size_t workerCount) { _StageWorkerCounts[(int)stage] = workerCount; }
+            size_t GetStageWorkerCount(const ExportStage stage) const;
+
+            // File format for exported textures (BIM). Model textures are always PNG.
+            void SetImageFormat(const ImageExportFormat imageFormat) { _ImageFormat = imageFormat; }
+
+            // File format for exported models (LWO, MD6)
+            void SetModelFormat(const ModelExportFormat modelFormat) { _ModelFormat = modelFormat; }
+
+            // Write the material2 .decls used by exported models next to them
+            void SetWriteMaterialDecls(const bool writeMaterialDecls) { _WriteMaterialDecls = writeMaterialDecls; }
+
+            // Whether an entry is a file type and variant that can be exported
+            static bool IsExportSupported(const ResourceEntry& entry);
+
+            // Tasks from the last ExportFiles call, with their Result
+            const std::vector<ExportTask>& GetExportJobQueue() const { return _ExportJobQueue; }
 
         private:
+            size_t _WorkerCount = 0;
+            ImageExportFormat _ImageFormat = ImageExportFormat::PNG;
+            ModelExportFormat _ModelFormat = ModelExportFormat::OBJ;
+            bool _WriteMaterialDecls = 1;
+            ExportCache _ExportCache;                   // model dependencies shared within one ExportFiles call
+            size_t _StageWorkerCounts[4] = { 0, 0, 0, 0 };
             std::vector<ExportTask> _ExportJobQueue;     
-            std::vector<std::string> _BIMFileNames;
-            std::vector<std::string> _LWOFileNames;
-            std::vector<std::string> _MD6FileNames;
-            std::vector<std::string> _DECLFileNames;
-            std::vector<std::string> _COMPFileNames;
+            std::unordered_set<std::string> _BIMFileNames;
+            std::unordered_set<std::string> _LWOFileNames;
+            std::unordered_set<std::string> _MD6FileNames;
+            std::unordered_set<std::string> _DECLFileNames;
+            std::unordered_set<std::string> _COMPFileNames;
+
+            bool RunExportStage(const ExportStage stage, const ExportTask& task, ExportJob& job, const ResourceIndex& resourceIndex, const std::string& resourcePath, const StreamDBResolver& streamDBResolver);
     };
 }
\ No newline at end of file
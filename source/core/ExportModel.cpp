@@ -14,7 +14,7 @@ namespace HAYDEN
     }
 
     // Write the model data to OBJ file
-    void ModelExportTask::WriteOBJFile(const int modelType)
+    bool ModelExportTask::WriteOBJFile(const int modelType)
     {
         fs::path exportFolder = ModelExportPath;
         fs::path materialFile = ModelExportPath / fs::path(_FileName).filename().replace_extension(".mtl");
@@ -26,98 +26,73 @@ namespace HAYDEN
             if (!mkpath(ModelExportPath))
             {
                 fprintf(stderr, "Error: Failed to create directories for file: %s \n", ModelExportPath.string().c_str());
-                return;
+                return 0;
             }
         }
 
-        // Construct OBJ file from model data
+        // Stream model data to OBJ file
         OBJFile objFile;
+        bool written = 0;
 
         if (modelType == 31)
-            objFile.ConvertFromMD6(_MD6);
+            written = objFile.WriteMD6(_MD6, outputFile, materialFile.filename().string());
 
         if (modelType == 67)
-            objFile.ConvertFromLWO(_LWO);
+            written = objFile.WriteLWO(_LWO, outputFile, materialFile.filename().string());
 
-        // Open output stream
-        std::ofstream file;
-        file.open(outputFile.string(), std::ios::out);
+        if (!written)
+            fprintf(stderr, "Error: Failed to open file for writing: %s \n", outputFile.string().c_str());
 
-        // print header
-        file << objFile.SignatureLine + "\n\n";
-        objFile.MaterialLibrary = "mtllib " + materialFile.filename().string() + "\n\n";
-        file << objFile.MaterialLibrary;
+        return written;
+    }
 
-        for (int i = 0; i < objFile.Objects.size(); i++)
+    // Get the texture paths used by a material, relative to <ModelExportPath>. Paths are empty if not used.
+    void ModelExportTask::GetMaterialTextures(const MaterialInfo& materialInfo, fs::path& diffuseTexture, fs::path& specularTexture, fs::path& normalTexture)
+    {
+        for (int j = 0; j < materialInfo.TextureTypes.size(); j++)
         {
-            if (modelType == 67)
-            {
-                // print object name
-                file << objFile.Objects[i].ObjectName + "\n";
-            }
-
-            // print verts
-            for (int j = 0; j < objFile.Objects[i].Vertices.size(); j++)
-                file << objFile.Objects[i].Vertices[j] + "\n";
-
-            // print uvs
-            for (int j = 0; j < objFile.Objects[i].UVs.size(); j++)
-                file << objFile.Objects[i].UVs[j] + "\n";
-
-            // print normals
-            for (int j = 0; j < objFile.Objects[i].Normals.size(); j++)
-                file << objFile.Objects[i].Normals[j] + "\n";
-
-            if (modelType == 67)
-            {
-                // print usemtls
-                file << objFile.Objects[i].GroupLine + "\n";
-                file << objFile.Objects[i].UseMaterialLine + "\n";
-
-                // print faces
-                for (int j = 0; j < objFile.Objects[i].Faces.size(); j++)
-                    file << objFile.Objects[i].Faces[j] + "\n";
-            }
-
+            // diffuse types
+            if (materialInfo.TextureTypes[j] == "albedo")
+                diffuseTexture = materialInfo.TextureNames[j];
+            if (materialInfo.TextureTypes[j] == "eyealbedomap")
+                diffuseTexture = materialInfo.TextureNames[j];
+
+            // specular types
+            if (materialInfo.TextureTypes[j] == "specular")
+                specularTexture = materialInfo.TextureNames[j];
+
+            // normal types
+            if (materialInfo.TextureTypes[j] == "normal")
+                normalTexture = materialInfo.TextureNames[j];
+            if (materialInfo.TextureTypes[j] == "eyeemissivemap")
+                normalTexture = materialInfo.TextureNames[j];
         }
 
-        if (modelType == 31)
-        {
-            for (uint64_t i = 0; i < objFile.FaceMaterialGroups.size(); i++)
-            {
-                // print usemtls ONLY if not a duplicate of previous (works because they are sorted alphabetically)
-                if (i == 0)
-                {
-                    file << objFile.FaceMaterialGroups[i].GroupLine + "\n";
-                    file << objFile.FaceMaterialGroups[i].UseMaterialLine + "\n";
-                }
+        if (!diffuseTexture.empty())
+            diffuseTexture = "images" / diffuseTexture.filename().replace_extension(".png");
 
-                if (i > 0)
-                {
-                    if (objFile.FaceMaterialGroups[i].GroupLine != objFile.FaceMaterialGroups[i - 1].GroupLine)
-                    {
-                        file << objFile.FaceMaterialGroups[i].GroupLine + "\n";
-                        file << objFile.FaceMaterialGroups[i].UseMaterialLine + "\n";
-                    }
-                }
-            
-                // print faces
-                for (uint64_t j = 0; j < objFile.FaceMaterialGroups[i].Faces.size(); j++)
-                    file << objFile.FaceMaterialGroups[i].Faces[j] + "\n";
-            }
-        }
+        if (!specularTexture.empty())
+            specularTexture = "images" / specularTexture.filename().replace_extension(".png");
+
+        if (!normalTexture.empty())
+            normalTexture = "images" / normalTexture.filename().replace_extension(".png");
 
-        file.close();
         return;
     }
 
     // Write the MD6 material data to MTL file. File is written to <ModelExportPath>
-    void ModelExportTask::WriteMTLFile()
+    bool ModelExportTask::WriteMTLFile()
     {
         std::ofstream mtlfile;
         fs::path materialFile = ModelExportPath / fs::path(_FileName).filename().replace_extension(".mtl");
         mtlfile.open(materialFile.string(), std::ios::out);
 
+        if (!mtlfile.is_open())
+        {
+            fprintf(stderr, "Error: Failed to open file for writing: %s \n", materialFile.string().c_str());
+            return 0;
+        }
+
         for (int mtlNum = 0; mtlNum < MaterialData.size(); mtlNum++)
         {
             fs::path mtlPath = MaterialData[mtlNum].DeclFileName;
@@ -126,34 +101,7 @@ namespace HAYDEN
             fs::path diffuseTexture;
             fs::path specularTexture;
             fs::path normalTexture;
-
-            for (int j = 0; j < MaterialData[mtlNum].TextureTypes.size(); j++)
-            {
-                // diffuse types
-                if (MaterialData[mtlNum].TextureTypes[j] == "albedo")
-                    diffuseTexture = MaterialData[mtlNum].TextureNames[j];
-                if (MaterialData[mtlNum].TextureTypes[j] == "eyealbedomap")
-                    diffuseTexture = MaterialData[mtlNum].TextureNames[j];
-
-                // specular types
-                if (MaterialData[mtlNum].TextureTypes[j] == "specular")
-                    specularTexture = MaterialData[mtlNum].TextureNames[j];
-
-                // normal types
-                if (MaterialData[mtlNum].TextureTypes[j] == "normal")
-                    normalTexture = MaterialData[mtlNum].TextureNames[j];
-                if (MaterialData[mtlNum].TextureTypes[j] == "eyeemissivemap")
-                    normalTexture = MaterialData[mtlNum].TextureNames[j];
-            }
-
-            if (!diffuseTexture.empty())
-                diffuseTexture = "images" / diffuseTexture.filename().replace_extension(".png");
-
-            if (!specularTexture.empty())
-                specularTexture = "images" / specularTexture.filename().replace_extension(".png");
-
-            if (!normalTexture.empty())
-                normalTexture = "images" / normalTexture.filename().replace_extension(".png");
+            GetMaterialTextures(MaterialData[mtlNum], diffuseTexture, specularTexture, normalTexture);
 
             mtlfile << "newmtl " + mtlName + " \n";
             mtlfile << "illum 4 \n";                                        // DOOM Eternal uses Maya, which always exports as illum 4.
@@ -172,11 +120,63 @@ namespace HAYDEN
         }
 
         mtlfile.close();
-        return;
+        if (mtlfile.fail())
+        {
+            fprintf(stderr, "Error: Failed to write file: %s \n", materialFile.string().c_str());
+            return 0;
+        }
+        return 1;
+    }
+
+    // Write the model and its materials to a binary glTF file. File is written to <ModelExportPath>
+    bool ModelExportTask::WriteGLBFile(const int modelType)
+    {
+        fs::path outputFile = ModelExportPath / fs::path(_FileName).filename().replace_extension(".glb");
+
+        // Create output directories if needed
+        if (!fs::exists(ModelExportPath))
+        {
+            if (!mkpath(ModelExportPath))
+            {
+                fprintf(stderr, "Error: Failed to create directories for file: %s \n", ModelExportPath.string().c_str());
+                return 0;
+            }
+        }
+
+        // Same material names and textures as the .mtl file. Specular maps have no glTF core equivalent.
+        std::vector<GLBMaterial> materials;
+        for (int mtlNum = 0; mtlNum < MaterialData.size(); mtlNum++)
+        {
+            fs::path diffuseTexture;
+            fs::path specularTexture;
+            fs::path normalTexture;
+            GetMaterialTextures(MaterialData[mtlNum], diffuseTexture, specularTexture, normalTexture);
+
+            GLBMaterial material;
+            material.Name = fs::path(MaterialData[mtlNum].DeclFileName).filename().replace_extension("").string();
+            material.BaseColorTexture = diffuseTexture.generic_string();
+            material.NormalTexture = normalTexture.generic_string();
+            materials.push_back(material);
+        }
+
+        GLBFile glbFile;
+        bool written = 0;
+
+        if (modelType == 31)
+            written = glbFile.WriteMD6(_MD6, materials, outputFile);
+
+        if (modelType == 67)
+            written = glbFile.WriteLWO(_LWO, materials, outputFile);
+
+        if (!written)
+            fprintf(stderr, "Error: Failed to open file for writing: %s \n", outputFile.string().c_str());
+
+        return written;
     }
 
-    // Export Material2 DECL files used by this model. Files are written to <ModelExportPath>/material2/
-    void ModelExportTask::ExportMaterial2Decls(const std::vector<ResourceEntry>& resourceData, const GLOBAL_RESOURCES* globalResources)
+    // Parse Material2 DECL files used by this model, to determine which BIM textures need to be exported.
+    // Files are parsed from memory, and written to <ModelExportPath>/material2/ if WriteMaterialDecls is set.
+    void ModelExportTask::ReadMaterial2Decls(const ResourceIndex& resourceIndex)
     {
         for (uint64_t i = 0; i < MaterialData.size(); i++)
         {
@@ -187,74 +187,43 @@ namespace HAYDEN
             fs::path targetFilePath(targetFileName);
             fs::path outputFile = ModelExportPath / "material2" / targetFilePath.filename();
 
-            // Locate this file in current .resources
-            for (uint64_t j = 0; j < resourceData.size(); j++)
-            {
-                if (resourceData[j].Version != 0)
-                    continue;
+            auto loadDecl = [](const ResourceEntry& resourceEntry, const std::string& resourcePath) -> std::vector<uint8_t> {
+                DECLExportTask declExportTask(resourceEntry);
+                if (!declExportTask.ReadData(resourcePath) || !declExportTask.DecompressData())
+                    return std::vector<uint8_t>();
+                return declExportTask.GetFileData();
+            };
 
-                if (resourceData[j].Name == targetFileName)
-                {
-                    DECLExportTask declExportTask(resourceData[j]);
-                    found = declExportTask.Export(outputFile, ResourcePath);
-                    break;
-                }
-            }
+            auto readDecl = [&](const ResourceEntry& resourceEntry, const std::string& resourcePath) -> bool {
+                std::shared_ptr<const std::vector<uint8_t>> declData;
+                if (SharedExportCache != NULL)
+                    declData = SharedExportCache->LoadOnce(&resourceEntry, [&]() { return loadDecl(resourceEntry, resourcePath); });
+                else
+                    declData = std::make_shared<const std::vector<uint8_t>>(loadDecl(resourceEntry, resourcePath));
 
-            if (found)
-                continue;
+                if (declData == NULL || declData->empty())
+                    return 0;
 
-            // Unable to locate file in current .resources, search all global archives
-            for (int j = 0; j < globalResources->Files.size(); j++)
-            {
-                for (int k = 0; k < globalResources->Files[j].Entries.size(); k++)
+                if (WriteMaterialDecls)
                 {
-                    if (globalResources->Files[j].Entries[k].Version != 0)
-                        continue;
-
-                    if (globalResources->Files[j].Entries[k].Name == targetFileName)
-                    {
-                        DECLExportTask declExportTask(globalResources->Files[j].Entries[k]);
-                        found = declExportTask.Export(outputFile, globalResources->Files[j].ResourcePath.string());
-                        break;
-                    }
+                    auto writeDecl = [&]() { return writeToFilesystem(*declData, outputFile); };
+                    if (SharedExportCache != NULL)
+                        SharedExportCache->ExportOnce(&resourceEntry, outputFile, writeDecl);
+                    else
+                        writeDecl();
                 }
-                if (found)
-                    break;
-            }
-        }
-        return;
-    }
 
-    // Parse Material2 DECL files used by this MD6 model, to determine which BIM textures need to be exported.
-    void ModelExportTask::ReadMaterial2Decls()
-    {
-        for (int i = 0; i < MaterialData.size(); i++)
-        {
-            // model path
-            fs::path materialFolder = ModelExportPath / "material2";
-
-            // decl path
-            fs::path declFileName = MaterialData[i].DeclFileName + ".decl";
-            fs::path materialFile = materialFolder / declFileName.filename();
-
-            std::ifstream inputStream = std::ifstream(materialFile);
-            if (inputStream.is_open())
-            {
                 DeclFile declFile;
-                declFile.SetFileName(materialFile.string());
-                std::string line;
-                while (std::getline(inputStream, line))
-                {
-                    DeclSingleLine declSingleLine;
-                    declSingleLine.ReadFromStream(inputStream, line);
-                    declFile.SetLineData(declSingleLine);
-                    declFile.LineCount++;
-                }
-
+                declFile.SetFileName(targetFileName);
+                declFile.ReadFromMemory(*declData);
                 MaterialData[i].ParsedDeclFile = declFile;
-                inputStream.close();
-            }
+                return 1;
+            };
+
+            // Current .resources first, then global archives
+            const std::vector<ResourceLocation>& locations = resourceIndex.Find(0, targetFileName);
+            for (size_t j = 0; j < locations.size() && !found; j++)
+                found = readDecl(*locations[j].Entry, resourceIndex.GetArchivePath(locations[j].ArchiveIndex));
         }
 
         // find textures referenced in this file and add to MaterialData
@@ -264,7 +233,7 @@ namespace HAYDEN
             for (int lineNumber = 0; lineNumber < thisDeclFile.LineCount; lineNumber++)
             {
                 DeclSingleLine lineData = thisDeclFile.GetLineData(lineNumber);
-                if (lineData.GetLineVariable() != "filePath")
+                if (lineData.GetLineVariable() != "filePath" || lineNumber == 0)
                     continue;
 
                 DeclSingleLine prevLineData = thisDeclFile.GetLineData(lineNumber - 1);
@@ -282,7 +251,7 @@ namespace HAYDEN
     }
 
     // Export BIM textures used by this MD6 model. Files are written to <ModelExportPath>/images/
-    void ModelExportTask::ExportBIMTextures(const std::vector<ResourceEntry>& resourceData, const GLOBAL_RESOURCES* globalResources, const MaterialInfo& materialInfo, const std::vector<StreamDBFile>& streamDBFiles)
+    void ModelExportTask::ExportBIMTextures(const ResourceIndex& resourceIndex, const MaterialInfo& materialInfo, const StreamDBResolver& streamDBResolver)
     {
         for (uint64_t i = 0; i < materialInfo.TextureNames.size(); i++)
         {
@@ -293,88 +262,42 @@ namespace HAYDEN
             fs::path targetFilePath(targetFileName);
             fs::path outputFile = ModelExportPath / "images" / targetFilePath.filename().replace_extension(".png");
 
-            // Locate this file in .resources
-            for (uint64_t j = 0; j < resourceData.size(); j++)
+            // Current .resources first, then globals. Only the first usable candidate of each archive is tried.
+            const std::vector<ImageLocation>& candidates = resourceIndex.FindImages(targetFileName);
+            size_t triedArchive = -1;
+
+            for (size_t j = 0; j < candidates.size() && !found; j++)
             {
-                // Skip non-image files
-                if (resourceData[j].Version != 21)
+                const ImageLocation& candidate = candidates[j];
+                if (candidate.ArchiveIndex == triedArchive)
                     continue;
 
-                // Drop $ qualifiers from resourceData.Name
-                std::string compName = resourceData[j].Name;
-                size_t pos = compName.find("$");
-
-                if (pos != -1)
-                    compName = compName.substr(0, pos);
-
-                // Found
-                if (compName == targetFileName)
-                {
-                    // Check for smoothness texture - will have a slash somewhere in the truncated $ stuff
-                    if (pos != -1)
-                    {
-                        std::string smoothnessCheck = resourceData[j].Name.substr(pos, resourceData[j].Name.length());
-                        if ((smoothnessCheck.rfind("/") != -1) && (materialInfo.TextureTypes[i] != "smoothness"))
-                            continue;
-                    }
-
-                    BIMExportTask bimExportTask(resourceData[j]);
-                    found = bimExportTask.Export(outputFile, ResourcePath, streamDBFiles, true);
-                    break;
-                }
-            }
-
-            if (found)
-                continue;
-
-            // Unable to locate file in current .resources, search all global archives
-            for (int j = 0; j < globalResources->Files.size(); j++)
-            {
-                // Search each global archive
-                for (int k = 0; k < globalResources->Files[j].Entries.size(); k++)
-                {
-                    // Skip non-image files
-                    if (globalResources->Files[j].Entries[k].Version != 21)
-                        continue;
-
-                    // Drop $ qualifiers from resourceData.Name
-                    std::string compName = globalResources->Files[j].Entries[k].Name;
-                    size_t pos = compName.find("$");
-
-                    if (pos != -1)
-                        compName = compName.substr(0, pos);
-
-                    // Found
-                    if (compName == targetFileName)
-                    {
-                        // Check for smoothness texture - will have a slash somewhere in the truncated $ stuff
-                        if (pos != -1)
-                        {
-                            std::string smoothnessCheck = globalResources->Files[j].Entries[k].Name.substr(pos, globalResources->Files[j].Entries[k].Name.length());
-                            if ((smoothnessCheck.rfind("/") != -1) && (materialInfo.TextureTypes[i] != "smoothness"))
-                                continue;
-                        }
-
-                        BIMExportTask bimExportTask(globalResources->Files[j].Entries[k]);
-                        found = bimExportTask.Export(outputFile, globalResources->Files[j].ResourcePath.string(), streamDBFiles, true);
-                        break;
-                    }
-                }
+                // Smoothness maps are only used for smoothness textures
+                if (candidate.Smoothness && materialInfo.TextureTypes[i] != "smoothness")
+                    continue;
 
-                if (found)
-                    break;
+                triedArchive = candidate.ArchiveIndex;
+                auto exportTexture = [&]() {
+                    BIMExportTask bimExportTask(*candidate.Entry);
+                    return bimExportTask.Export(outputFile, resourceIndex.GetArchivePath(candidate.ArchiveIndex), streamDBResolver, true);
+                };
+
+                // Textures shared with other models in the batch are only decoded once
+                if (SharedExportCache != NULL)
+                    found = SharedExportCache->ExportOnce(candidate.Entry, outputFile, exportTexture);
+                else
+                    found = exportTexture();
             }
         }
         return;
     }
 
-    // Main export function for models.
-    // Return 1 for success, 0 for failure.
-    bool ModelExportTask::Export(const fs::path exportPath, const std::string resourcePath, const std::vector<StreamDBFile>& streamDBFiles, const std::vector<ResourceEntry>& resourceData, const GLOBAL_RESOURCES* globalResources, const int modelType)
+    // Read stage: model header from .resources file, and raw geometry from .streamdb
+    bool ModelExportTask::ReadData(const fs::path exportPath, const std::string resourcePath, const StreamDBResolver& streamDBResolver, const int modelType)
     {
         ModelExportPath = exportPath;
         ResourcePath = resourcePath;
-        std::vector<uint8_t> modelData;
+        _ModelType = modelType;
         ResourceFileReader resourceFile(resourcePath);
 
         // Extract model header from .resources file and read it
@@ -404,32 +327,30 @@ namespace HAYDEN
         // Convert resourceID to streamFileID
         _StreamedDataHash = resourceFile.CalculateStreamDBIndex(_ResourceID);
 
-        // Locate and extract the model geometry from .streamdb file
-        for (int i = 0; i < streamDBFiles.size(); i++)
-        {
-            _StreamDBEntry = streamDBFiles[i].LocateStreamDBEntry(_StreamedDataHash, _StreamedDataLength);
-
-            if (_StreamDBEntry.Offset16 > 0)
-            {
-                // Match found in this file
-                _StreamDBNumber = i;
-                _StreamDBFilePath = streamDBFiles[i].FilePath;
-                break;
-            }
-        }
+        // Locate the model geometry in .streamdb files
+        StreamDBLocation location = streamDBResolver.Locate(_StreamedDataHash, _StreamedDataLength);
 
         // Unable to locate geometry in .streamdb. Abort.
-        if (_StreamDBEntry.Offset16 <= 0)
+        if (!location.IsValid())
             return 0;
 
+        _StreamDBEntry = location.Entry;
+        _StreamDBNumber = location.FileIndex;
+        _StreamDBFilePath = streamDBResolver.GetFile(_StreamDBNumber).FilePath;
+
         // Extract model geometry from .streamdb file.
-        modelData = streamDBFiles[_StreamDBNumber].GetEmbeddedFile(_StreamDBFilePath, _StreamDBEntry);
+        _ModelData = streamDBResolver.GetFile(_StreamDBNumber).GetEmbeddedFile(_StreamDBFilePath, _StreamDBEntry);
+        return 1;
+    }
 
+    // Decompress stage
+    bool ModelExportTask::DecompressData()
+    {
         // Decompress the streamed model geometry if needed (almost always).
         if (_StreamDBEntry.CompressedSize != _StreamedDataLengthDecompressed)
         {
-            modelData = oodleDecompress(modelData, _StreamedDataLengthDecompressed);
-            if (modelData.empty())
+            _ModelData = oodleDecompress(_ModelData, _StreamedDataLengthDecompressed);
+            if (_ModelData.empty())
             {
                 fprintf(stderr, "Error: Failed to decompress: %s \n", _FileName.c_str());
                 return 0;
@@ -437,14 +358,18 @@ namespace HAYDEN
         }
 
         // FOR DEBUGGING ONLY - EXPORT RAW BINARIES AND ABORT
-        // writeToFilesystem(binaryData, exportPath);
-        // writeToFilesystem(modelData, exportPath);
+        // writeToFilesystem(_ModelData, ModelExportPath);
         // return 0;
+        return 1;
+    }
 
+    // Convert stage: serialize geometry, then export the materials and textures it uses
+    bool ModelExportTask::ConvertData(const StreamDBResolver& streamDBResolver, const ResourceIndex& resourceIndex)
+    {
         // Serialize model data and get materials (MD6)
-        if (modelType == 31)
+        if (_ModelType == 31)
         {
-            _MD6.Serialize(_MD6Header, modelData);
+            _MD6.Serialize(_MD6Header, _ModelData);
             for (int i = 0; i < _MD6Header.MeshInfo.size(); i++)
             {
                 MaterialInfo materialInfo;
@@ -454,9 +379,9 @@ namespace HAYDEN
         }
 
         // Serialize model data and get materials (LWO)
-        if (modelType == 67)
+        if (_ModelType == 67)
         {
-            _LWO.Serialize(_LWOHeader, modelData);
+            _LWO.Serialize(_LWOHeader, _ModelData);
             for (int i = 0; i < _LWOHeader.MeshInfo.size(); i++)
             {
                 MaterialInfo materialInfo;
@@ -465,6 +390,9 @@ namespace HAYDEN
             }
         }
 
+        _ModelData.clear();
+        _ModelData.shrink_to_fit();
+
         // Remove any duplicate materials
         std::sort(MaterialData.begin(), MaterialData.end(), [](const MaterialInfo& a, const MaterialInfo& b) {
             return (a.DeclFileName < b.DeclFileName);
@@ -479,16 +407,29 @@ namespace HAYDEN
         size_t listSize = it - MaterialData.begin();
         MaterialData.resize(listSize);
 
-        // Export the material2 .decls and parse them for textures used in this model
-        ExportMaterial2Decls(resourceData, globalResources);
-        ReadMaterial2Decls();
+        // Parse the material2 .decls for textures used in this model
+        ReadMaterial2Decls(resourceIndex);
 
         // Find required textures and export them
         for (int i = 0; i < MaterialData.size(); i++)
-            ExportBIMTextures(resourceData, globalResources, MaterialData[i], streamDBFiles);
+            ExportBIMTextures(resourceIndex, MaterialData[i], streamDBResolver);
 
-        WriteOBJFile(modelType);
-        WriteMTLFile();
         return 1;
     }
-}
+
+    // Write stage
+    bool ModelExportTask::WriteData(const ModelExportFormat modelFormat)
+    {
+        if (modelFormat == ModelExportFormat::GLB)
+            return WriteGLBFile(_ModelType);
+
+        return WriteOBJFile(_ModelType) && WriteMTLFile();
+    }
+
+    // Main export function for models.
+    // Return 1 for success, 0 for failure.
+    bool ModelExportTask::Export(const fs::path exportPath, const std::string resourcePath, const StreamDBResolver& streamDBResolver, const ResourceIndex& resourceIndex, const int modelType, const ModelExportFormat modelFormat)
+    {
+        return ReadData(exportPath, resourcePath, streamDBResolver, modelType) && DecompressData() && ConvertData(streamDBResolver, resourceIndex) && WriteData(modelFormat);
+    }
+}
\ No newline at end of file
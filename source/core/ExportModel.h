@@ -5,6 +5,7 @@
 #include <filesystem>
 
 #include "exportTypes/DDSHeader.h"
+#include "exportTypes/GLB.h"
 #include "exportTypes/OBJ.h"
 #include "exportTypes/PNG.h"
 
@@ -18,14 +19,24 @@
 #include "Common.h"
 #include "ExportDECL.h"
 #include "ExportBIM.h"
+#include "ExportCache.h"
 #include "Oodle.h"
 #include "ResourceFileReader.h"
+#include "ResourceIndex.h"
+#include "StreamDBResolver.h"
 #include "Utilities.h"
 
 namespace fs = std::filesystem;
 
 namespace HAYDEN
 {
+    // File format for exported models
+    enum class ModelExportFormat
+    {
+        OBJ = 0,
+        GLB = 1
+    };
+
     // Holds material2 .decl data used by the model
     struct MaterialInfo
     {
@@ -43,20 +54,38 @@ namespace HAYDEN
             fs::path ModelExportPath;
             std::vector<MaterialInfo> MaterialData;
 
-            // OBJ export functions. Consider moving to OBJ.h
-            void WriteMTLFile();
-            void WriteOBJFile(const int modelType);
+            // Write the material2 .decls to <ModelExportPath>/material2/. They are parsed from memory either way.
+            bool WriteMaterialDecls = 1;
+
+            // Shares material2 decls and textures with other models in the same batch. NULL = no sharing.
+            ExportCache* SharedExportCache = NULL;
+
+            // OBJ export functions, return 0 on failure. Consider moving to OBJ.h
+            bool WriteMTLFile();
+            bool WriteOBJFile(const int modelType);
+
+            // GLB export. Writes a single .glb file, textures are referenced from images/. Return 0 on failure.
+            bool WriteGLBFile(const int modelType);
 
             // Dependency export functions (material2 .decls and BIM textures)
-            void ExportBIMTextures(const std::vector<ResourceEntry>& resourceData, const GLOBAL_RESOURCES* globalResources, const MaterialInfo& materialInfo, const std::vector<StreamDBFile>& streamDBFiles);
-            void ExportMaterial2Decls(const std::vector<ResourceEntry>& resourceData, const GLOBAL_RESOURCES* globalResources);
-            void ReadMaterial2Decls();
+            void ExportBIMTextures(const ResourceIndex& resourceIndex, const MaterialInfo& materialInfo, const StreamDBResolver& streamDBResolver);
+            void ReadMaterial2Decls(const ResourceIndex& resourceIndex);
+
+            // Export stages, in order. Each returns 0 on failure.
+            bool ReadData(const fs::path exportPath, const std::string resourcePath, const StreamDBResolver& streamDBResolver, const int modelType);
+            bool DecompressData();
+            bool ConvertData(const StreamDBResolver& streamDBResolver, const ResourceIndex& resourceIndex);
+            bool WriteData(const ModelExportFormat modelFormat = ModelExportFormat::OBJ);
 
-            bool Export(const fs::path exportPath, const std::string resourcePath, const std::vector<StreamDBFile>& streamDBFiles, const std::vector<ResourceEntry>& resourceData, const GLOBAL_RESOURCES* globalResources, const int modelType);
+            // Runs all stages
+            bool Export(const fs::path exportPath, const std::string resourcePath, const StreamDBResolver& streamDBResolver, const ResourceIndex& resourceIndex, const int modelType, const ModelExportFormat modelFormat = ModelExportFormat::OBJ);
             ModelExportTask(const ResourceEntry resourceEntry);
 
         private:
 
+            // Texture paths used by a material, relative to <ModelExportPath>
+            void GetMaterialTextures(const MaterialInfo& materialInfo, fs::path& diffuseTexture, fs::path& specularTexture, fs::path& normalTexture);
+
             // Name of the file we are exporting, as it appears in a *.resources file
             std::string _FileName;
 
@@ -72,7 +101,7 @@ namespace HAYDEN
             uint64_t _StreamedDataLength = 0;
             uint64_t _StreamedDataLengthDecompressed = 0;
             int32_t _StreamCompressionType = 0;
-            int32_t _StreamDBNumber = -1;                            // index into std::vector<StreamDBFile>& streamDBFiles
+            int32_t _StreamDBNumber = -1;                            // index into StreamDBResolver files
 
             // Matching StreamDBEntry for the model
             StreamDBEntry _StreamDBEntry;
@@ -86,5 +115,11 @@ namespace HAYDEN
             LWO_HEADER _LWOHeader;
 
             std::vector<Mesh> _StreamedGeometry;
+
+            // 31 = MD6, 67 = LWO
+            int _ModelType = 0;
+
+            // Streamed geometry between stages (raw -> decompressed)
+            std::vector<uint8_t> _ModelData;
     };
 }
\ No newline at end of file
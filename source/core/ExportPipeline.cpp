@@ -0,0 +1,75 @@
+#include "ExportPipeline.h"
+
+namespace HAYDEN
+{
+    // Stages run in the order they are added. workerCount = 0 uses 1 worker.
+    void ExportPipeline::AddStage(const std::string name, const size_t workerCount, StageFunction function)
+    {
+        Stage stage;
+        stage.Name = name;
+        stage.WorkerCount = workerCount > 0 ? workerCount : 1;
+        stage.Function = std::move(function);
+        _Stages.push_back(std::move(stage));
+    }
+
+    // Pushes items 0..numItems-1 through all stages. Returns when every item is done.
+    void ExportPipeline::Run(const size_t numItems)
+    {
+        if (_Stages.empty() || numItems == 0)
+            return;
+
+        // queues[i] feeds stage i. No stage needs more workers than there are items.
+        std::vector<std::unique_ptr<BoundedQueue<size_t>>> queues;
+        std::vector<std::unique_ptr<std::atomic<size_t>>> runningWorkers;
+        std::vector<size_t> workerCounts;
+        for (size_t i = 0; i < _Stages.size(); i++)
+        {
+            size_t workerCount = std::min(_Stages[i].WorkerCount, numItems);
+            size_t capacity = _QueueCapacity > 0 ? _QueueCapacity : workerCount * 2;
+            queues.push_back(std::make_unique<BoundedQueue<size_t>>(capacity));
+            runningWorkers.push_back(std::make_unique<std::atomic<size_t>>(workerCount));
+            workerCounts.push_back(workerCount);
+        }
+
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < _Stages.size(); i++)
+        {
+            for (size_t j = 0; j < workerCounts[i]; j++)
+            {
+                workers.emplace_back([this, i, &queues, &runningWorkers]() {
+                    const Stage& stage = _Stages[i];
+                    BoundedQueue<size_t>* nextQueue = i + 1 < queues.size() ? queues[i + 1].get() : NULL;
+
+                    size_t item = 0;
+                    while (queues[i]->Pop(item))
+                    {
+                        bool passed = 0;
+                        try
+                        {
+                            passed = stage.Function(item);
+                        }
+                        catch (...)
+                        {
+                            fprintf(stderr, "Error: Export pipeline stage \"%s\" failed. \n", stage.Name.c_str());
+                        }
+
+                        if (passed && nextQueue != NULL)
+                            nextQueue->Push(item);
+                    }
+
+                    // Last worker of this stage out closes the next queue
+                    if (--(*runningWorkers[i]) == 0 && nextQueue != NULL)
+                        nextQueue->Close();
+                });
+            }
+        }
+
+        // Feed the first stage. Blocks while the first queue is full.
+        for (size_t i = 0; i < numItems; i++)
+            queues[0]->Push(i);
+        queues[0]->Close();
+
+        for (size_t i = 0; i < workers.size(); i++)
+            workers[i].join();
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+
+#include "BoundedQueue.h"
+
+namespace HAYDEN
+{
+    // Runs items through a fixed sequence of stages (e.g. read -> decompress -> convert -> write).
+    // Every stage has its own worker threads, and stages are connected by bounded queues,
+    // so I/O-bound and CPU-bound stages overlap without competing for the same threads.
+    class ExportPipeline
+    {
+        public:
+
+            // Processes one item, identified by its index. Return 0 to drop the item from later stages.
+            typedef std::function<bool(size_t)> StageFunction;
+
+            // Stages run in the order they are added. workerCount = 0 uses 1 worker.
+            void AddStage(const std::string name, const size_t workerCount, StageFunction function);
+
+            // Pushes items 0..numItems-1 through all stages. Returns when every item is done.
+            void Run(const size_t numItems);
+
+            // Max items waiting between two stages. 0 = twice the worker count of the next stage.
+            ExportPipeline(const size_t queueCapacity = 0) { _QueueCapacity = queueCapacity; }
+
+        private:
+
+            struct Stage
+            {
+                std::string Name;
+                size_t WorkerCount = 1;
+                StageFunction Function;
+            };
+
+            size_t _QueueCapacity = 0;
+            std::vector<Stage> _Stages;
+    };
+}
@@ -0,0 +1,109 @@
+#include "FileHandlePool.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace HAYDEN
+{
+    PooledFile::PooledFile(const fs::path& path)
+    {
+#ifdef _WIN32
+        _Handle = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+        _Handle = open(path.string().c_str(), O_RDONLY);
+#endif
+    }
+
+    PooledFile::~PooledFile()
+    {
+#ifdef _WIN32
+        if (_Handle != INVALID_HANDLE_VALUE)
+            CloseHandle(_Handle);
+#else
+        if (_Handle != -1)
+            close(_Handle);
+#endif
+    }
+
+    bool PooledFile::IsOpen() const
+    {
+#ifdef _WIN32
+        return _Handle != INVALID_HANDLE_VALUE;
+#else
+        return _Handle != -1;
+#endif
+    }
+
+    // Positional read, does not move any shared file pointer. Returns number of bytes read.
+    uint64_t PooledFile::ReadAt(const uint64_t offset, uint8_t* buffer, const uint64_t size) const
+    {
+        uint64_t totalRead = 0;
+        while (totalRead < size)
+        {
+            // Read in chunks of at most 1GB
+            uint64_t chunkSize = std::min<uint64_t>(size - totalRead, 0x40000000);
+            uint64_t chunkOffset = offset + totalRead;
+
+#ifdef _WIN32
+            // Each read carries its own offset, so concurrent reads on one handle are safe
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = (DWORD)(chunkOffset & 0xFFFFFFFF);
+            overlapped.OffsetHigh = (DWORD)(chunkOffset >> 32);
+
+            DWORD bytesRead = 0;
+            if (!ReadFile(_Handle, buffer + totalRead, (DWORD)chunkSize, &bytesRead, &overlapped) || bytesRead == 0)
+                break;
+#else
+            ssize_t bytesRead = pread(_Handle, buffer + totalRead, chunkSize, chunkOffset);
+            if (bytesRead <= 0)
+                break;
+#endif
+            totalRead += bytesRead;
+        }
+        return totalRead;
+    }
+
+    // Pool shared by all readers
+    FileHandlePool& FileHandlePool::GetSharedPool()
+    {
+        static FileHandlePool sharedPool;
+        return sharedPool;
+    }
+
+    // Returns the cached descriptor for this file, opening it if needed. NULL if it can't be opened.
+    std::shared_ptr<PooledFile> FileHandlePool::Acquire(const fs::path& path)
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        std::shared_ptr<PooledFile>& file = _Files[path.string()];
+
+        if (file == NULL)
+        {
+            file = std::make_shared<PooledFile>(path);
+            if (!file->IsOpen())
+            {
+                _Files.erase(path.string());
+                return NULL;
+            }
+        }
+        return file;
+    }
+
+    // Reads up to size bytes at offset. Returns number of bytes read, or -1 if the file can't be opened.
+    int64_t FileHandlePool::ReadAt(const fs::path& path, const uint64_t offset, uint8_t* buffer, const uint64_t size)
+    {
+        std::shared_ptr<PooledFile> file = Acquire(path);
+        if (file == NULL)
+            return -1;
+
+        return file->ReadAt(offset, buffer, size);
+    }
+
+    // Drops all cached descriptors. Reads in progress keep their descriptor until they finish.
+    void FileHandlePool::CloseAll()
+    {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        _Files.clear();
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <mutex>
+#include <cstdint>
+#include <unordered_map>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace HAYDEN
+{
+    // One open, read-only descriptor for a file in the pool
+    class PooledFile
+    {
+        public:
+
+            bool IsOpen() const;
+
+            // Positional read, does not move any shared file pointer. Returns number of bytes read.
+            uint64_t ReadAt(const uint64_t offset, uint8_t* buffer, const uint64_t size) const;
+
+            PooledFile(const fs::path& path);
+            PooledFile(const PooledFile&) = delete;
+            PooledFile& operator=(const PooledFile&) = delete;
+            ~PooledFile();
+
+        private:
+
+#ifdef _WIN32
+            HANDLE _Handle = INVALID_HANDLE_VALUE;
+#else
+            int _Handle = -1;
+#endif
+    };
+
+    // Thread-safe pool that keeps one descriptor open per archive (.resources/.streamdb),
+    // so embedded files can be read without an open/seek/close for every asset.
+    class FileHandlePool
+    {
+        public:
+
+            // Reads up to size bytes at offset. Returns number of bytes read, or -1 if the file can't be opened.
+            int64_t ReadAt(const fs::path& path, const uint64_t offset, uint8_t* buffer, const uint64_t size);
+
+            // Drops all cached descriptors. Reads in progress keep their descriptor until they finish.
+            void CloseAll();
+
+            // Pool shared by all readers
+            static FileHandlePool& GetSharedPool();
+
+        private:
+
+            std::mutex _Mutex;
+            std::unordered_map<std::string, std::shared_ptr<PooledFile>> _Files;
+
+            std::shared_ptr<PooledFile> Acquire(const fs::path& path);
+    };
+}
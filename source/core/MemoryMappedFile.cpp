@@ -0,0 +1,117 @@
+#include "MemoryMappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace HAYDEN
+{
+    // Returns a pointer to [offset, offset + length), or NULL if the range is outside the file.
+    const uint8_t* MemoryMappedFile::GetRange(const uint64_t offset, const uint64_t length) const
+    {
+        if (_Data == NULL || offset > _Size || length > _Size - offset)
+            return NULL;
+
+        return _Data + offset;
+    }
+
+    // Maps the whole file into memory, read-only. Return 1 on success.
+    bool MemoryMappedFile::Open(const fs::path& path)
+    {
+        Close();
+
+#ifdef _WIN32
+        _FileHandle = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (_FileHandle == INVALID_HANDLE_VALUE)
+            return 0;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(_FileHandle, &fileSize) || fileSize.QuadPart == 0)
+        {
+            Close();
+            return 0;
+        }
+
+        _MappingHandle = CreateFileMappingW(_FileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (_MappingHandle == NULL)
+        {
+            Close();
+            return 0;
+        }
+
+        _Data = (const uint8_t*)MapViewOfFile(_MappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (_Data == NULL)
+        {
+            Close();
+            return 0;
+        }
+
+        _Size = fileSize.QuadPart;
+#else
+        int fd = open(path.string().c_str(), O_RDONLY);
+        if (fd == -1)
+            return 0;
+
+        struct stat fileInfo;
+        if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size == 0)
+        {
+            close(fd);
+            return 0;
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        void* mapping = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if (mapping == MAP_FAILED)
+            return 0;
+
+        _Data = (const uint8_t*)mapping;
+        _Size = fileInfo.st_size;
+#endif
+        return 1;
+    }
+
+    void MemoryMappedFile::Close()
+    {
+#ifdef _WIN32
+        if (_Data != NULL)
+            UnmapViewOfFile(_Data);
+        if (_MappingHandle != NULL)
+            CloseHandle(_MappingHandle);
+        if (_FileHandle != INVALID_HANDLE_VALUE)
+            CloseHandle(_FileHandle);
+
+        _MappingHandle = NULL;
+        _FileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (_Data != NULL)
+            munmap((void*)_Data, _Size);
+#endif
+        _Data = NULL;
+        _Size = 0;
+    }
+
+    MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        Close();
+        std::swap(_Data, other._Data);
+        std::swap(_Size, other._Size);
+#ifdef _WIN32
+        std::swap(_FileHandle, other._FileHandle);
+        std::swap(_MappingHandle, other._MappingHandle);
+#endif
+        return *this;
+    }
+}
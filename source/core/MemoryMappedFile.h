@@ -0,0 +1,48 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#include <string>
+#include <cstdint>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+namespace HAYDEN
+{
+    // Read-only memory mapping of a whole file. The mapping lives as long as this object.
+    class MemoryMappedFile
+    {
+        public:
+
+            bool IsOpen() const { return _Data != NULL; }
+            const uint8_t* Data() const { return _Data; }
+            uint64_t Size() const { return _Size; }
+
+            // Returns a pointer to [offset, offset + length), or NULL if the range is outside the file.
+            const uint8_t* GetRange(const uint64_t offset, const uint64_t length) const;
+
+            bool Open(const fs::path& path);
+            void Close();
+
+            MemoryMappedFile() {};
+            MemoryMappedFile(const fs::path& path) { Open(path); }
+            MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+            MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+            MemoryMappedFile(const MemoryMappedFile&) = delete;
+            MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+            ~MemoryMappedFile() { Close(); }
+
+        private:
+
+            const uint8_t* _Data = NULL;
+            uint64_t _Size = 0;
+
+#ifdef _WIN32
+            HANDLE _FileHandle = INVALID_HANDLE_VALUE;
+            HANDLE _MappingHandle = NULL;
+#endif
+    };
+}
@@ -4,6 +4,7 @@ namespace HAYDEN
 {
     // Decompress using Oodle DLL
     OodLZ_DecompressFunc* OodLZ_Decompress = NULL;
+    OodLZDecoder_MemorySizeNeededFunc* OodLZDecoder_MemorySizeNeeded = NULL;
     bool oodleInit(const std::string& basePath)
     {
         std::string oodlePath = basePath.substr(0, basePath.length() - 4) + "oo2core_8_win64.dll";
@@ -15,6 +16,7 @@ namespace HAYDEN
             return false;
 
         OodLZ_Decompress = (OodLZ_DecompressFunc*)GetProcAddress(oodle, "OodleLZ_Decompress");
+        OodLZDecoder_MemorySizeNeeded = (OodLZDecoder_MemorySizeNeededFunc*)GetProcAddress(oodle, "OodleLZDecoder_MemorySizeNeeded");
 #else
         std::error_code ec;
 
@@ -31,6 +33,7 @@ namespace HAYDEN
         std::string linoodlePath = basePath + "/liblinoodle.so";
         auto oodle = dlopen(linoodlePath.c_str(), RTLD_LAZY);
         OodLZ_Decompress = (OodLZ_DecompressFunc*)dlsym(oodle, "OodleLZ_Decompress");
+        OodLZDecoder_MemorySizeNeeded = (OodLZDecoder_MemorySizeNeededFunc*)dlsym(oodle, "OodleLZDecoder_MemorySizeNeeded");
 
         // Remove oodle dll
         if (copied)
@@ -43,23 +46,50 @@ namespace HAYDEN
         return true;
     }
 
-    std::vector<uint8_t> oodleDecompress(std::vector<uint8_t> compressedData, const uint64_t decompressedSize)
+    uint64_t OodleDecoder::Decompress(const uint8_t* compressedData, const uint64_t compressedSize, uint8_t* output, const uint64_t decompressedSize)
     {
         if (OodLZ_Decompress == NULL)
-            return std::vector<uint8_t>();
+            return 0;
 
-        std::vector<uint8_t> output(decompressedSize + SAFE_SPACE);
-        uint64_t outbytes = 0;
+        // Grow scratch memory to fit this decode. Without the size query, Oodle allocates its own.
+        if (OodLZDecoder_MemorySizeNeeded != NULL)
+        {
+            int64_t scratchSize = OodLZDecoder_MemorySizeNeeded(-1, decompressedSize);
+            if (scratchSize > 0 && (size_t)scratchSize > _Scratch.size())
+                _Scratch.resize(scratchSize);
+        }
 
         // Decompress using Oodle DLL
-        outbytes = OodLZ_Decompress(compressedData.data(), compressedData.size(), output.data(), decompressedSize, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        void* scratch = _Scratch.empty() ? NULL : _Scratch.data();
+        int outbytes = OodLZ_Decompress(const_cast<uint8_t*>(compressedData), compressedSize, output, decompressedSize, 0, 0, 0, 0, 0, 0, 0, scratch, _Scratch.size(), 0);
 
-        if (outbytes == 0)
+        if (outbytes <= 0)
         {
             fprintf(stderr, "Error: failed to decompress with Oodle DLL.\n\n");
-            return std::vector<uint8_t>();
+            return 0;
         }
+        return outbytes;
+    }
+
+    // Export pipeline workers are long-lived threads, so each keeps its scratch memory across tasks
+    OodleDecoder& OodleDecoder::GetThreadDecoder()
+    {
+        thread_local OodleDecoder decoder;
+        return decoder;
+    }
+
+    uint64_t oodleDecompress(const uint8_t* compressedData, const uint64_t compressedSize, uint8_t* output, const uint64_t decompressedSize)
+    {
+        return OodleDecoder::GetThreadDecoder().Decompress(compressedData, compressedSize, output, decompressedSize);
+    }
+
+    std::vector<uint8_t> oodleDecompress(const std::vector<uint8_t>& compressedData, const uint64_t decompressedSize)
+    {
+        std::vector<uint8_t> output(decompressedSize + SAFE_SPACE);
+        uint64_t outbytes = oodleDecompress(compressedData.data(), compressedData.size(), output.data(), decompressedSize);
 
-        return std::vector<uint8_t>(output.begin(), output.begin() + outbytes);
+        // Shrinking keeps the allocation, no copy
+        output.resize(outbytes);
+        return output;
     }
 }
\ No newline at end of file
@@ -16,11 +16,38 @@ typedef int OodLZ_DecompressFunc(
     uint8_t* src_buf, int src_len, uint8_t* dst, size_t dst_size, int fuzz, int crc, int verbose,
     uint8_t* dst_base, size_t e, void* cb, void* cb_ctx, void* scratch, size_t scratch_size, int threadPhase);
 
+// Optional export, compressor = -1 covers any compressor
+typedef int64_t OodLZDecoder_MemorySizeNeededFunc(int compressor, int64_t rawLen);
+
 namespace fs = std::filesystem;
 
 namespace HAYDEN
 {
     // Decompress using Oodle DLL
     bool oodleInit(const std::string& basePath);
-    std::vector<uint8_t> oodleDecompress(std::vector<uint8_t> compressedData, const uint64_t decompressedSize);
+
+    // Reusable decoder state. Owns the scratch memory handed to Oodle, so decoding
+    // doesn't allocate inside the DLL on every call. Not thread-safe, one per worker thread.
+    class OodleDecoder
+    {
+        public:
+            // Same contract as oodleDecompress below
+            uint64_t Decompress(const uint8_t* compressedData, const uint64_t compressedSize, uint8_t* output, const uint64_t decompressedSize);
+
+            // Current scratch size in bytes. Grows to fit the largest decode seen so far.
+            size_t GetScratchSize() const { return _Scratch.size(); }
+
+            // Decoder owned by the calling thread, used by oodleDecompress
+            static OodleDecoder& GetThreadDecoder();
+
+        private:
+            std::vector<uint8_t> _Scratch;
+    };
+
+    // Decompress into a caller-provided buffer, which must have room for decompressedSize + SAFE_SPACE bytes.
+    // Returns the number of bytes written, 0 on failure. Uses the calling thread's OodleDecoder.
+    uint64_t oodleDecompress(const uint8_t* compressedData, const uint64_t compressedSize, uint8_t* output, const uint64_t decompressedSize);
+
+    // Decompress into a new vector. Returns an empty vector on failure.
+    std::vector<uint8_t> oodleDecompress(const std::vector<uint8_t>& compressedData, const uint64_t decompressedSize);
 }
\ No newline at end of file
@@ -34,38 +34,56 @@ namespace HAYDEN
         return streamDBIndex;
     }
 
-    // Retrieve embedded file header for a specific entry in .resources file
-    std::vector<uint8_t> ResourceFileReader::GetEmbeddedFileHeader(const std::string resourcePath, const uint64_t fileOffset, const uint64_t compressedSize, const uint64_t decompressedSize)
+    // Read raw (possibly compressed) embedded file data from .resources file. Return 1 on success.
+    bool ResourceFileReader::ReadEmbeddedFile(const std::string resourcePath, const uint64_t fileOffset, const uint64_t size, std::vector<uint8_t>& fileData) const
     {
-        FILE* f = fopen(resourcePath.c_str(), "rb");
-        std::vector<uint8_t> embeddedHeader(compressedSize);
+        // Read through the shared handle pool, the archive stays open between calls
+        fileData.resize(size);
+        int64_t bytesRead = FileHandlePool::GetSharedPool().ReadAt(resourcePath, fileOffset, fileData.data(), size);
 
-        if (f != NULL)
+        if (bytesRead < 0)
         {
-            fseek(f, (long)fileOffset, SEEK_SET);
-            fread(embeddedHeader.data(), 1, compressedSize, f);
-
-            if (embeddedHeader.size() != decompressedSize)
-                embeddedHeader = oodleDecompress(embeddedHeader, decompressedSize);
+            fileData.clear();
+            fprintf(stderr, "Error: failed to open %s for reading.\n", resourcePath.c_str());
+            return 0;
+        }
 
-            fclose(f);
+        // Short read, the archive was truncated or modified
+        if (bytesRead != (int64_t)size)
+        {
+            fileData.clear();
+            fprintf(stderr, "Error: failed to read %llu bytes at offset %llu from %s.\n", (unsigned long long)size, (unsigned long long)fileOffset, resourcePath.c_str());
+            return 0;
         }
-        else
+        return 1;
+    }
+
+    // Retrieve embedded file header for a specific entry in .resources file.
+    // Decompressed headers are kept in the shared DecompressedDataCache.
+    std::vector<uint8_t> ResourceFileReader::GetEmbeddedFileHeader(const std::string resourcePath, const uint64_t fileOffset, const uint64_t compressedSize, const uint64_t decompressedSize)
+    {
+        DecompressedDataCache& cache = DecompressedDataCache::GetSharedCache();
+        auto cachedHeader = cache.Find(resourcePath, fileOffset, compressedSize);
+        if (cachedHeader != NULL)
+            return *cachedHeader;
+
+        std::vector<uint8_t> embeddedHeader;
+        if (ReadEmbeddedFile(resourcePath, fileOffset, compressedSize, embeddedHeader) && embeddedHeader.size() != decompressedSize)
         {
-            embeddedHeader.clear();
-            fprintf(stderr, "Error: failed to open %s for reading.\n", resourcePath.c_str());
+            embeddedHeader = oodleDecompress(embeddedHeader, decompressedSize);
+            cache.Insert(resourcePath, fileOffset, compressedSize, embeddedHeader);
         }
-        
+
         return embeddedHeader;
     }
 
     // Public function for retrieving .resources data in a user-friendly format
     std::vector<ResourceEntry> ResourceFileReader::ParseResourceFile()
     {
-        // read .resources file from filesystem
+        // map .resources file from filesystem
         ResourceFile resourceFile(ResourceFilePath);
-        std::vector<uint64_t> pathStringIndexes = resourceFile.GetAllPathStringIndexes();
         uint32_t numFileEntries = resourceFile.GetNumFileEntries();
+        uint32_t numPathStringIndexes = resourceFile.GetNumPathStringIndexes();
 
         // allocate vector to hold all entries from this .resources file
         std::vector<ResourceEntry> resourceData;
@@ -74,14 +92,19 @@ namespace HAYDEN
         // Parse each resource file and convert to usable data
         for (uint32_t i = 0; i < numFileEntries; i++)
         {
-            ResourceFileEntry& lexedEntry = resourceFile.GetResourceFileEntry(i);
+            const ResourceFileEntry& lexedEntry = resourceFile.GetResourceFileEntry(i);
             resourceData[i].DataOffset = lexedEntry.DataOffset;
             resourceData[i].DataSize = lexedEntry.DataSize;
             resourceData[i].DataSizeUncompressed = lexedEntry.DataSizeUncompressed;
             resourceData[i].Version = lexedEntry.Version;
             resourceData[i].StreamResourceHash = lexedEntry.StreamResourceHash;
-            resourceData[i].Type = resourceFile.GetResourceStringEntry(pathStringIndexes[lexedEntry.PathTuple_Index]);
-            resourceData[i].Name = resourceFile.GetResourceStringEntry(pathStringIndexes[lexedEntry.PathTuple_Index + 1]);
+
+            // Strings are only copied out of the mapping here
+            if (lexedEntry.PathTuple_Index + 1 < numPathStringIndexes)
+            {
+                resourceData[i].Type = resourceFile.GetResourceStringEntry(resourceFile.GetPathStringIndex(lexedEntry.PathTuple_Index));
+                resourceData[i].Name = resourceFile.GetResourceStringEntry(resourceFile.GetPathStringIndex(lexedEntry.PathTuple_Index + 1));
+            }
         }
         return resourceData;
     };
@@ -6,7 +6,9 @@
 
 #include "idFileTypes/ResourceFile.h"
 
+#include "DecompressedDataCache.h"
 #include "Oodle.h"
+#include "FileHandlePool.h"
 #include "Utilities.h"
 
 namespace fs = std::filesystem;
@@ -33,6 +35,7 @@ namespace HAYDEN
 
             std::vector<ResourceEntry> ParseResourceFile();
             uint64_t CalculateStreamDBIndex(uint64_t resourceId, const int mipCount = -6) const;
+            bool ReadEmbeddedFile(const std::string resourcePath, const uint64_t fileOffset, const uint64_t size, std::vector<uint8_t>& fileData) const;
             std::vector<uint8_t> GetEmbeddedFileHeader(const std::string resourcePath, const uint64_t fileOffset, const uint64_t compressedSize, const uint64_t decompressedSize);
             ResourceFileReader(const fs::path resourceFilePath) { ResourceFilePath = resourceFilePath; }
     };
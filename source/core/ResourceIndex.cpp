@@ -0,0 +1,76 @@
+#include "ResourceIndex.h"
+
+namespace HAYDEN
+{
+    void ResourceIndex::AddArchive(const std::string& resourcePath, const std::vector<ResourceEntry>& entries)
+    {
+        size_t archiveIndex = _Archives.size();
+        _Archives.push_back({ resourcePath, &entries });
+        _Index.reserve(_Index.size() + entries.size());
+
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            // Only the first entry with a given name counts within an archive
+            std::vector<ResourceLocation>& locations = _Index[{ (int)entries[i].Version, entries[i].Name }];
+            if (!locations.empty() && locations.back().ArchiveIndex == archiveIndex)
+                continue;
+
+            locations.push_back({ archiveIndex, &entries[i] });
+        }
+
+        // Images are also looked up by name without $ qualifiers
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (entries[i].Version != 21)
+                continue;
+
+            std::string_view name = entries[i].Name;
+            size_t qualifierStart = name.find('$');
+
+            ImageLocation image;
+            image.ArchiveIndex = archiveIndex;
+            image.Entry = &entries[i];
+
+            if (qualifierStart != std::string_view::npos)
+            {
+                image.Qualifiers = name.substr(qualifierStart);
+                image.Smoothness = image.Qualifiers.find('/') != std::string_view::npos;
+                image.MinMip = image.Qualifiers.find("$minmip") != std::string_view::npos;
+                name = name.substr(0, qualifierStart);
+            }
+
+            _ImageIndex[name].push_back(image);
+        }
+    }
+
+    void ResourceIndex::Clear()
+    {
+        _Archives.clear();
+        _Index.clear();
+        _ImageIndex.clear();
+    }
+
+    // First matching entry of every archive containing this file, in priority order. Empty if not found.
+    const std::vector<ResourceLocation>& ResourceIndex::Find(const int version, const std::string_view name) const
+    {
+        static const std::vector<ResourceLocation> notFound;
+
+        auto it = _Index.find({ version, name });
+        if (it == _Index.end())
+            return notFound;
+
+        return it->second;
+    }
+
+    // All images whose name without $ qualifiers matches, in priority order, then archive order. Empty if not found.
+    const std::vector<ImageLocation>& ResourceIndex::FindImages(const std::string_view baseName) const
+    {
+        static const std::vector<ImageLocation> notFound;
+
+        auto it = _ImageIndex.find(baseName);
+        if (it == _ImageIndex.end())
+            return notFound;
+
+        return it->second;
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+#include "ResourceFileReader.h"
+
+namespace HAYDEN
+{
+    // Result of a ResourceIndex lookup
+    struct ResourceLocation
+    {
+        size_t ArchiveIndex = 0;                    // lookup priority, 0 = highest
+        const ResourceEntry* Entry = NULL;
+    };
+
+    // Image (BIM) entry, found by its name without $ qualifiers
+    struct ImageLocation
+    {
+        size_t ArchiveIndex = 0;
+        const ResourceEntry* Entry = NULL;
+        std::string_view Qualifiers;                // "$..." part of the name, empty if none
+        bool Smoothness = 0;                        // qualifiers contain a path (smoothness maps)
+        bool MinMip = 0;                            // $minmip qualifier
+    };
+
+    // Hash index from (version, name) to entries across all loaded .resources archives.
+    // Archives are added in lookup priority order: the currently loaded .resources first, then globals in load order.
+    // Names are not copied, so entries must outlive this index (or the next Clear call).
+    class ResourceIndex
+    {
+        public:
+
+            void AddArchive(const std::string& resourcePath, const std::vector<ResourceEntry>& entries);
+            void Clear();
+
+            size_t GetArchiveCount() const { return _Archives.size(); }
+            const std::string& GetArchivePath(const size_t archiveIndex) const { return _Archives[archiveIndex].ResourcePath; }
+            const std::vector<ResourceEntry>& GetArchiveEntries(const size_t archiveIndex) const { return *_Archives[archiveIndex].Entries; }
+
+            // First matching entry of every archive containing this file, in priority order. Empty if not found.
+            const std::vector<ResourceLocation>& Find(const int version, const std::string_view name) const;
+
+            // All images whose name without $ qualifiers matches, in priority order, then archive order. Empty if not found.
+            const std::vector<ImageLocation>& FindImages(const std::string_view baseName) const;
+
+        private:
+
+            struct Archive
+            {
+                std::string ResourcePath;
+                const std::vector<ResourceEntry>* Entries = NULL;
+            };
+
+            struct Key
+            {
+                int Version = 0;
+                std::string_view Name;
+                bool operator==(const Key& other) const { return Version == other.Version && Name == other.Name; }
+            };
+
+            struct KeyHash
+            {
+                size_t operator()(const Key& key) const { return std::hash<std::string_view>()(key.Name) ^ ((size_t)key.Version * 0x9E3779B97F4A7C15ull); }
+            };
+
+            std::vector<Archive> _Archives;
+            std::unordered_map<Key, std::vector<ResourceLocation>, KeyHash> _Index;
+            std::unordered_map<std::string_view, std::vector<ImageLocation>> _ImageIndex;
+    };
+}
@@ -0,0 +1,226 @@
+#include "ResourceIndexCache.h"
+
+#include <map>
+#include <thread>
+
+namespace HAYDEN
+{
+    // Identifies the exact version of a .resources file the cache was built from
+    struct SourceFileIdentity
+    {
+        std::string Path;
+        uint64_t Size = 0;
+        int64_t ModifiedTime = 0;
+    };
+
+    static bool GetSourceFileIdentity(const fs::path& resourcePath, SourceFileIdentity& identity)
+    {
+        std::error_code ec;
+        identity.Path = fs::absolute(resourcePath, ec).lexically_normal().string();
+        if (ec)
+            return 0;
+
+        identity.Size = fs::file_size(resourcePath, ec);
+        if (ec)
+            return 0;
+
+        identity.ModifiedTime = fs::last_write_time(resourcePath, ec).time_since_epoch().count();
+        if (ec)
+            return 0;
+
+        return 1;
+    }
+
+    // Default to the per-user cache directory for this platform
+    ResourceIndexCache::ResourceIndexCache()
+    {
+#ifdef _WIN32
+        const char* localAppData = getenv("LOCALAPPDATA");
+        if (localAppData != NULL)
+        {
+            CacheDirectory = fs::path(localAppData) / "SAMUEL" / "cache";
+            return;
+        }
+#else
+        const char* xdgCacheHome = getenv("XDG_CACHE_HOME");
+        const char* home = getenv("HOME");
+        if (xdgCacheHome != NULL && xdgCacheHome[0] != 0)
+        {
+            CacheDirectory = fs::path(xdgCacheHome) / "samuel";
+            return;
+        }
+        if (home != NULL && home[0] != 0)
+        {
+            CacheDirectory = fs::path(home) / ".cache" / "samuel";
+            return;
+        }
+#endif
+        std::error_code ec;
+        fs::path tempDirectory = fs::temp_directory_path(ec);
+        if (!ec)
+            CacheDirectory = tempDirectory / "samuel_cache";
+    }
+
+    // Cache files are named after a FNV-1a hash of the absolute source path
+    fs::path ResourceIndexCache::GetCacheFilePath(const std::string& sourcePath) const
+    {
+        uint64_t hash = 0xCBF29CE484222325;
+        for (size_t i = 0; i < sourcePath.size(); i++)
+        {
+            hash ^= (uint8_t)sourcePath[i];
+            hash *= 0x100000001B3;
+        }
+
+        std::string fileName = fs::path(sourcePath).filename().string() + "." + intToHex(hash) + ".idx";
+        return CacheDirectory / fileName;
+    }
+
+    // Reads cached entries for this .resources file. Return 1 on success, 0 if missing or stale.
+    bool ResourceIndexCache::Load(const fs::path& resourcePath, std::vector<ResourceEntry>& entries) const
+    {
+        SourceFileIdentity identity;
+        if (CacheDirectory.empty() || !GetSourceFileIdentity(resourcePath, identity))
+            return 0;
+
+        fs::path cacheFilePath = GetCacheFilePath(identity.Path);
+        std::error_code ec;
+        if (!fs::exists(cacheFilePath, ec))
+            return 0;
+
+        MemoryMappedFile cacheFile(cacheFilePath);
+        const ResourceIndexCacheHeader* header = (const ResourceIndexCacheHeader*)cacheFile.GetRange(0, sizeof(ResourceIndexCacheHeader));
+        if (header == NULL)
+            return 0;
+
+        // Validate against the current state of the .resources file
+        ResourceIndexCacheHeader expected;
+        if (header->Magic != expected.Magic || header->FormatVersion != expected.FormatVersion)
+            return 0;
+
+        if (header->SourceSize != identity.Size || header->SourceModifiedTime != identity.ModifiedTime || header->SourcePathLength != identity.Path.size())
+            return 0;
+
+        uint64_t offset = sizeof(ResourceIndexCacheHeader);
+        const char* sourcePath = (const char*)cacheFile.GetRange(offset, header->SourcePathLength);
+        if (sourcePath == NULL || identity.Path.compare(0, std::string::npos, sourcePath, header->SourcePathLength) != 0)
+            return 0;
+
+        offset += header->SourcePathLength;
+        const ResourceIndexCacheEntry* cachedEntries = (const ResourceIndexCacheEntry*)cacheFile.GetRange(offset, (uint64_t)header->NumEntries * sizeof(ResourceIndexCacheEntry));
+        offset += (uint64_t)header->NumEntries * sizeof(ResourceIndexCacheEntry);
+
+        const char* stringData = (const char*)cacheFile.GetRange(offset, header->StringDataSize);
+        if (cachedEntries == NULL || stringData == NULL)
+            return 0;
+
+        // Convert to ResourceEntry
+        std::vector<ResourceEntry> loadedEntries(header->NumEntries);
+        for (uint32_t i = 0; i < header->NumEntries; i++)
+        {
+            const ResourceIndexCacheEntry& cachedEntry = cachedEntries[i];
+            if ((uint64_t)cachedEntry.NameOffset + cachedEntry.NameLength > header->StringDataSize || (uint64_t)cachedEntry.TypeOffset + cachedEntry.TypeLength > header->StringDataSize)
+                return 0;
+
+            loadedEntries[i].DataOffset = cachedEntry.DataOffset;
+            loadedEntries[i].DataSize = cachedEntry.DataSize;
+            loadedEntries[i].DataSizeUncompressed = cachedEntry.DataSizeUncompressed;
+            loadedEntries[i].StreamResourceHash = cachedEntry.StreamResourceHash;
+            loadedEntries[i].Version = cachedEntry.Version;
+            loadedEntries[i].CompressionMode = cachedEntry.CompressionMode;
+            loadedEntries[i].Name.assign(stringData + cachedEntry.NameOffset, cachedEntry.NameLength);
+            loadedEntries[i].Type.assign(stringData + cachedEntry.TypeOffset, cachedEntry.TypeLength);
+        }
+
+        entries = std::move(loadedEntries);
+        return 1;
+    }
+
+    // Writes entries for this .resources file to the cache. Return 1 on success.
+    bool ResourceIndexCache::Store(const fs::path& resourcePath, const std::vector<ResourceEntry>& entries) const
+    {
+        SourceFileIdentity identity;
+        if (CacheDirectory.empty() || !GetSourceFileIdentity(resourcePath, identity))
+            return 0;
+
+        ResourceIndexCacheHeader header;
+        header.SourceSize = identity.Size;
+        header.SourceModifiedTime = identity.ModifiedTime;
+        header.SourcePathLength = (uint32_t)identity.Path.size();
+        header.NumEntries = (uint32_t)entries.size();
+
+        // Build string data. Type strings repeat a lot, so they are only stored once.
+        std::string stringData;
+        std::map<std::string, uint32_t> typeOffsets;
+        std::vector<ResourceIndexCacheEntry> cachedEntries(entries.size());
+
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            cachedEntries[i].DataOffset = entries[i].DataOffset;
+            cachedEntries[i].DataSize = entries[i].DataSize;
+            cachedEntries[i].DataSizeUncompressed = entries[i].DataSizeUncompressed;
+            cachedEntries[i].StreamResourceHash = entries[i].StreamResourceHash;
+            cachedEntries[i].Version = entries[i].Version;
+            cachedEntries[i].CompressionMode = entries[i].CompressionMode;
+
+            auto typeOffset = typeOffsets.find(entries[i].Type);
+            if (typeOffset == typeOffsets.end())
+            {
+                typeOffset = typeOffsets.emplace(entries[i].Type, (uint32_t)stringData.size()).first;
+                stringData += entries[i].Type;
+            }
+            cachedEntries[i].TypeOffset = typeOffset->second;
+            cachedEntries[i].TypeLength = (uint32_t)entries[i].Type.size();
+
+            cachedEntries[i].NameOffset = (uint32_t)stringData.size();
+            cachedEntries[i].NameLength = (uint32_t)entries[i].Name.size();
+            stringData += entries[i].Name;
+        }
+        header.StringDataSize = stringData.size();
+
+        if (!mkpath(CacheDirectory))
+            return 0;
+
+        // Write to a temporary file first, so a concurrent reader never sees a partial cache file
+        fs::path cacheFilePath = GetCacheFilePath(identity.Path);
+        fs::path tempFilePath = cacheFilePath;
+        tempFilePath += "." + intToHex(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+        FILE* f = fopen(tempFilePath.string().c_str(), "wb");
+        if (f == NULL)
+            return 0;
+
+        bool written = fwrite(&header, sizeof(header), 1, f) == 1
+            && fwrite(identity.Path.data(), 1, identity.Path.size(), f) == identity.Path.size()
+            && fwrite(cachedEntries.data(), sizeof(ResourceIndexCacheEntry), cachedEntries.size(), f) == cachedEntries.size()
+            && fwrite(stringData.data(), 1, stringData.size(), f) == stringData.size();
+        fclose(f);
+
+        std::error_code ec;
+        if (written)
+            fs::rename(tempFilePath, cacheFilePath, ec);
+
+        if (!written || ec)
+        {
+            fs::remove(tempFilePath, ec);
+            return 0;
+        }
+        return 1;
+    }
+
+    // Returns the parsed entries for a .resources file, from cache if it is still valid.
+    std::vector<ResourceEntry> ResourceIndexCache::ReadResourceEntries(const fs::path& resourcePath) const
+    {
+        std::vector<ResourceEntry> entries;
+        if (Load(resourcePath, entries))
+            return entries;
+
+        // Cache miss or stale cache: parse the .resources file and refresh the cache
+        ResourceFileReader reader(resourcePath);
+        entries = reader.ParseResourceFile();
+
+        if (!entries.empty() && !Store(resourcePath, entries))
+            fprintf(stderr, "Warning: Failed to write index cache for %s \n", resourcePath.string().c_str());
+
+        return entries;
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#include "MemoryMappedFile.h"
+#include "ResourceFileReader.h"
+
+#pragma pack(push)  // Not portable, sorry.
+#pragma pack(1)     // Works on my machine (TM).
+
+namespace fs = std::filesystem;
+
+namespace HAYDEN
+{
+    /**
+    *   Notes on the index cache format:
+    *
+    *   Each parsed .resources file gets one cache file, named after a hash of its absolute path.
+    *   The cache file stores the source path, size and mtime it was built from; if any of these
+    *   no longer match (e.g. after a game patch), the cache file is ignored and rebuilt.
+    *
+    *   Layout:
+    *     (a) ResourceIndexCacheHeader
+    *     (b) source path string (not null-terminated)
+    *     (c) NumEntries x ResourceIndexCacheEntry
+    *     (d) string data, referenced by offset/length from the entries
+    */
+
+    struct ResourceIndexCacheHeader
+    {
+        uint32_t Magic = 0x58444953;                // "SIDX"
+        uint32_t FormatVersion = 1;
+        uint64_t SourceSize = 0;
+        int64_t SourceModifiedTime = 0;
+        uint32_t SourcePathLength = 0;
+        uint32_t NumEntries = 0;
+        uint64_t StringDataSize = 0;
+    };
+
+    struct ResourceIndexCacheEntry
+    {
+        uint64_t DataOffset = 0;
+        uint64_t DataSize = 0;
+        uint64_t DataSizeUncompressed = 0;
+        uint64_t StreamResourceHash = 0;
+        uint32_t Version = 0;
+        uint16_t CompressionMode = 0;
+        uint16_t Pad = 0;
+        uint32_t NameOffset = 0;                    // offsets into the string data section
+        uint32_t NameLength = 0;
+        uint32_t TypeOffset = 0;
+        uint32_t TypeLength = 0;
+    };
+
+    class ResourceIndexCache
+    {
+        public:
+
+            // Where cache files are stored. Caching is disabled if empty.
+            fs::path CacheDirectory;
+
+            // Returns the parsed entries for a .resources file, from cache if it is still valid.
+            std::vector<ResourceEntry> ReadResourceEntries(const fs::path& resourcePath) const;
+
+            // Return 1 on success
+            bool Load(const fs::path& resourcePath, std::vector<ResourceEntry>& entries) const;
+            bool Store(const fs::path& resourcePath, const std::vector<ResourceEntry>& entries) const;
+
+            ResourceIndexCache();
+
+        private:
+
+            fs::path GetCacheFilePath(const std::string& sourcePath) const;
+    };
+}
+
+#pragma pack(pop)
@@ -0,0 +1,133 @@
+#include "ResourceSearchIndex.h"
+
+namespace HAYDEN
+{
+    // Indexes the names of these entries. Search results are indexes into this vector.
+    void ResourceSearchIndex::Build(const std::vector<ResourceEntry>& entries)
+    {
+        Clear();
+
+        size_t blobSize = 0;
+        for (size_t i = 0; i < entries.size(); i++)
+            blobSize += entries[i].Name.size();
+
+        _NameBlob.reserve(blobSize);
+        _NameOffsets.reserve(entries.size() + 1);
+
+        for (uint32_t i = 0; i < entries.size(); i++)
+        {
+            _NameOffsets.push_back((uint32_t)_NameBlob.size());
+            for (size_t j = 0; j < entries[i].Name.size(); j++)
+                _NameBlob.push_back((char)::tolower((uint8_t)entries[i].Name[j]));
+
+            // Entries are added in order, so each list stays sorted. Skip repeats within one name.
+            std::string_view name = GetName(i);
+            for (size_t j = 0; j + 3 <= name.size(); j++)
+            {
+                std::vector<uint32_t>& postings = _Trigrams[GetTrigram(name.data() + j)];
+                if (postings.empty() || postings.back() != i)
+                    postings.push_back(i);
+            }
+        }
+        _NameOffsets.push_back((uint32_t)_NameBlob.size());
+        return;
+    }
+
+    void ResourceSearchIndex::Clear()
+    {
+        _NameBlob.clear();
+        _NameOffsets.clear();
+        _Trigrams.clear();
+        _LastWords.clear();
+        _LastResults.clear();
+        return;
+    }
+
+    // Entries that may contain every word: the intersection of the posting lists of all trigrams in the words.
+    // Words shorter than 3 characters don't narrow anything down.
+    void ResourceSearchIndex::FindCandidates(const std::vector<std::string>& words, std::vector<uint32_t>& candidates) const
+    {
+        std::vector<const std::vector<uint32_t>*> postingLists;
+        for (size_t i = 0; i < words.size(); i++)
+        {
+            for (size_t j = 0; j + 3 <= words[i].size(); j++)
+            {
+                auto it = _Trigrams.find(GetTrigram(words[i].data() + j));
+                if (it == _Trigrams.end())
+                {
+                    candidates.clear();
+                    return;
+                }
+                postingLists.push_back(&it->second);
+            }
+        }
+
+        if (postingLists.empty())
+        {
+            candidates.resize(GetEntryCount());
+            for (uint32_t i = 0; i < candidates.size(); i++)
+                candidates[i] = i;
+            return;
+        }
+
+        // Intersect starting from the shortest list
+        std::sort(postingLists.begin(), postingLists.end(), [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return a->size() < b->size(); });
+        candidates = *postingLists[0];
+
+        std::vector<uint32_t> intersection;
+        for (size_t i = 1; i < postingLists.size() && !candidates.empty(); i++)
+        {
+            intersection.clear();
+            std::set_intersection(candidates.begin(), candidates.end(), postingLists[i]->begin(), postingLists[i]->end(), std::back_inserter(intersection));
+            candidates.swap(intersection);
+        }
+        return;
+    }
+
+    // Sorted indexes of entries whose name contains every word. Empty words are ignored.
+    const std::vector<uint32_t>& ResourceSearchIndex::Search(const std::vector<std::string>& words)
+    {
+        std::vector<std::string> searchWords;
+        for (size_t i = 0; i < words.size(); i++)
+        {
+            if (words[i].empty())
+                continue;
+
+            std::string word = words[i];
+            std::transform(word.begin(), word.end(), word.begin(), [](char c) { return (char)::tolower((uint8_t)c); });
+            searchWords.push_back(word);
+        }
+
+        // A name containing every new word also contains every previous word,
+        // if each previous word is part of a new one. Then only the previous results can match.
+        bool extendsLastSearch = !_LastWords.empty();
+        for (size_t i = 0; i < _LastWords.size() && extendsLastSearch; i++)
+        {
+            extendsLastSearch = std::any_of(searchWords.begin(), searchWords.end(), [&](const std::string& word) { return word.find(_LastWords[i]) != -1; });
+        }
+
+        std::vector<uint32_t> candidates;
+        if (extendsLastSearch)
+            candidates.swap(_LastResults);
+        else
+            FindCandidates(searchWords, candidates);
+
+        // Trigrams only rule entries out, check the actual names
+        std::vector<uint32_t> results;
+        results.reserve(candidates.size());
+        for (size_t i = 0; i < candidates.size(); i++)
+        {
+            std::string_view name = GetName(candidates[i]);
+            bool matched = 1;
+            for (size_t j = 0; j < searchWords.size() && matched; j++)
+                matched = name.find(searchWords[j]) != -1;
+
+            if (matched)
+                results.push_back(candidates[i]);
+        }
+
+        _LastWords = std::move(searchWords);
+        _LastResults = std::move(results);
+        return _LastResults;
+    }
+}
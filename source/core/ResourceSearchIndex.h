@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cctype>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+#include "ResourceFileReader.h"
+
+namespace HAYDEN
+{
+    // Case-insensitive substring search over entry names, fast enough to run on every keystroke.
+    // Names are stored lowercase in one blob, with a trigram index to find candidates.
+    // Not thread-safe.
+    class ResourceSearchIndex
+    {
+        public:
+
+            // Indexes the names of these entries. Search results are indexes into this vector.
+            void Build(const std::vector<ResourceEntry>& entries);
+            void Clear();
+
+            // Sorted indexes of entries whose name contains every word. Empty words are ignored.
+            // If every word of the previous query is part of a word in this one (e.g. the user kept typing),
+            // only the previous results are checked.
+            const std::vector<uint32_t>& Search(const std::vector<std::string>& words);
+
+            size_t GetEntryCount() const { return _NameOffsets.empty() ? 0 : _NameOffsets.size() - 1; }
+
+        private:
+
+            std::string _NameBlob;                                          // lowercase names, back to back
+            std::vector<uint32_t> _NameOffsets;                             // name i is [_NameOffsets[i], _NameOffsets[i + 1])
+            std::unordered_map<uint32_t, std::vector<uint32_t>> _Trigrams;  // 3 lowercase bytes -> sorted entry indexes
+
+            std::vector<std::string> _LastWords;
+            std::vector<uint32_t> _LastResults;
+
+            std::string_view GetName(const uint32_t index) const { return std::string_view(_NameBlob).substr(_NameOffsets[index], _NameOffsets[index + 1] - _NameOffsets[index]); }
+            void FindCandidates(const std::vector<std::string>& words, std::vector<uint32_t>& candidates) const;
+            static uint32_t GetTrigram(const char* text) { return (uint32_t)(uint8_t)text[0] | ((uint32_t)(uint8_t)text[1] << 8) | ((uint32_t)(uint8_t)text[2] << 16); }
+    };
+}
@@ -96,8 +96,10 @@ namespace HAYDEN
     }
     
     // Read all *.streamdb file entries from _StreamDBFileList into memory
-    void SAMUEL::ReadStreamDBFiles()
+    void SAMUEL::ReadStreamDBFiles(ThreadPool& threadPool)
     {
+        // Open every .streamdb concurrently, results are kept in _StreamDBFileList order
+        std::vector<std::future<StreamDBFile>> streamDBFiles;
         for (auto i = _StreamDBFileList.begin(); i != _StreamDBFileList.end(); ++i)
         {
             // build filepath
@@ -110,13 +112,23 @@ namespace HAYDEN
 
             // read streamdb file into memory
             fs::path fsPath = filePath;
-            StreamDBFile streamDBFile(fsPath);
-            _StreamDBFileData.push_back(streamDBFile);
+            streamDBFiles.push_back(threadPool.Submit([fsPath]() { return StreamDBFile(fsPath); }));
         }
+
+        // _StreamDBFileList keeps growing across loads, so rebuild the whole list to avoid duplicates.
+        // Collect into a local first: if a read throws, the resolver still points at the old, intact data.
+        std::vector<StreamDBFile> streamDBFileData;
+        streamDBFileData.reserve(streamDBFiles.size());
+        for (int i = 0; i < streamDBFiles.size(); i++)
+            streamDBFileData.push_back(streamDBFiles[i].get());
+
+        // Merged lookup across all files, in _StreamDBFileList priority order
+        _StreamDBFileData.swap(streamDBFileData);
+        _StreamDBResolver.Build(_StreamDBFileData);
     }
 
     // Loads all global *.resources data into memory (needed for LWO export)
-    void SAMUEL::LoadGlobalResources()
+    void SAMUEL::LoadGlobalResources(ThreadPool& threadPool)
     {
         // List of globally loaded *.resources, in order of load priority
         std::vector<std::string> globalResourceList =
@@ -128,7 +140,10 @@ namespace HAYDEN
             "warehouse.resources"
         };
 
-        // Load globals
+        std::vector<RESOURCES_ARCHIVE> globalResources;
+        std::vector<std::future<std::vector<ResourceEntry>>> globalResourceEntries;
+
+        // Load globals concurrently
         for (int i = 0; i < globalResourceList.size(); i++)
         {
             RESOURCES_ARCHIVE globalResource;
@@ -136,32 +151,36 @@ namespace HAYDEN
             globalResource.ResourcePath = fs::path(_BasePath) / fs::path(globalResource.ResourceName);
             globalResource.ResourcePath.make_preferred();
 
-            ResourceFileReader reader(globalResource.ResourcePath.string());
-            globalResource.Entries = reader.ParseResourceFile();
-            _GlobalResources->Files.push_back(globalResource);
+            fs::path resourcePath = globalResource.ResourcePath;
+            globalResourceEntries.push_back(threadPool.Submit([this, resourcePath]() { return _IndexCache.ReadResourceEntries(resourcePath); }));
+            globalResources.push_back(globalResource);
         }
         
-        // If current *.resources file is a global resource, we can stop here
-        if ((_ResourceFileName.find("gameresources") != -1) || (_ResourceFileName.find("warehouse") != -1))
-            return;
+        // If current *.resources file is a patch of a non-global, we need to load the non-patch version alongside our globals
+        bool isGlobalResource = (_ResourceFileName.find("gameresources") != -1) || (_ResourceFileName.find("warehouse") != -1);
+        bool isPatch = _ResourceFileName.rfind("_patch") != -1;
 
-        // If current *.resources file is NOT a patch, we can stop here
-        if (_ResourceFileName.rfind("_patch") == -1)
-            return;
+        if (!isGlobalResource && isPatch)
+        {
+            size_t patchSeparator = _ResourceFileName.rfind("_patch");
+            std::string unpatchedResourceName = _ResourceFileName.substr(0, patchSeparator);
+            fs::path unpatchedResourcePath = fs::path(_ResourcePath).remove_filename() / fs::path(unpatchedResourceName).replace_extension(".resources");
+            unpatchedResourcePath.make_preferred();
 
-        // Otherwise, we need to load the non-patch version of this *.resources file alongside our globals
-        size_t patchSeparator = _ResourceFileName.rfind("_patch");
-        std::string unpatchedResourceName = _ResourceFileName.substr(0, patchSeparator);
-        fs::path unpatchedResourcePath = fs::path(_ResourcePath).remove_filename() / fs::path(unpatchedResourceName).replace_extension(".resources");
-        unpatchedResourcePath.make_preferred();
+            RESOURCES_ARCHIVE unpatchedResource;
+            unpatchedResource.ResourcePath = unpatchedResourcePath;
+            unpatchedResource.ResourceName = unpatchedResourcePath.filename().string();
 
-        RESOURCES_ARCHIVE unpatchedResource;
-        unpatchedResource.ResourcePath = unpatchedResourcePath;
-        unpatchedResource.ResourceName = unpatchedResourcePath.filename().string();
+            globalResourceEntries.push_back(threadPool.Submit([this, unpatchedResourcePath]() { return _IndexCache.ReadResourceEntries(unpatchedResourcePath); }));
+            globalResources.push_back(unpatchedResource);
+        }
 
-        ResourceFileReader reader(unpatchedResource.ResourcePath.string());
-        unpatchedResource.Entries = reader.ParseResourceFile();
-        _GlobalResources->Files.push_back(unpatchedResource);
+        // Merge results in load priority order
+        for (int i = 0; i < globalResources.size(); i++)
+        {
+            globalResources[i].Entries = globalResourceEntries[i].get();
+            _GlobalResources->Files.push_back(std::move(globalResources[i]));
+        }
 
         return;
     }
@@ -174,9 +193,16 @@ namespace HAYDEN
         _ResourceFileName = fs::path(_ResourcePath).filename().string();
 
         // Clear any existing .resources data
+        _ResourceIndex.Clear();
         _ResourceData.clear();
         _GlobalResources->Files.clear();
 
+        // Close archive handles left open by exports from the previous .resources file
+        FileHandlePool::GetSharedPool().CloseAll();
+
+        // Archives may have been modified since they were cached
+        DecompressedDataCache::GetSharedCache().Clear();
+
         // Make sure this is a *.resources file
         if (_ResourcePath.rfind(".resources") == -1)
         {
@@ -186,11 +212,15 @@ namespace HAYDEN
         }
 
         // Load the currently requested *.resources file + globals.
+        // All archives are parsed concurrently; the pool is reused for .streamdb files below.
+        ThreadPool threadPool;
+
         try
         {
-            ResourceFileReader reader(_ResourcePath);
-            _ResourceData = reader.ParseResourceFile();
-            LoadGlobalResources();
+            fs::path resourcePath = _ResourcePath;
+            std::future<std::vector<ResourceEntry>> resourceData = threadPool.Submit([this, resourcePath]() { return _IndexCache.ReadResourceEntries(resourcePath); });
+            LoadGlobalResources(threadPool);
+            _ResourceData = resourceData.get();
         }
         catch (...)
         {
@@ -199,13 +229,18 @@ namespace HAYDEN
             return 0;
         }
 
+        // Name lookup across the current .resources and globals, in priority order
+        _ResourceIndex.AddArchive(_ResourcePath, _ResourceData);
+        for (int i = 0; i < _GlobalResources->Files.size(); i++)
+            _ResourceIndex.AddArchive(_GlobalResources->Files[i].ResourcePath.string(), _GlobalResources->Files[i].Entries);
+
         // Load .streamdb data
         try
         {
             UpdateStreamDBFileList("gameresources.resources");      
             UpdateStreamDBFileList("warehouse.resources");          
             UpdateStreamDBFileList(_ResourcePath);   
-            ReadStreamDBFiles();
+            ReadStreamDBFiles(threadPool);
         }
         catch (...)
         {
@@ -220,7 +255,16 @@ namespace HAYDEN
     bool SAMUEL::ExportFiles(const fs::path outputDirectory, const std::vector<std::vector<std::string>> filesToExport)
     {
         ExportManager exportManager;
-        return exportManager.ExportFiles(_GlobalResources, _ResourceData, _ResourcePath, _StreamDBFileData, outputDirectory, filesToExport);
+        exportManager.SetWorkerCount(_ExportWorkerCount);
+        exportManager.SetImageFormat(_ImageExportFormat);
+        exportManager.SetModelFormat(_ModelExportFormat);
+        exportManager.SetWriteMaterialDecls(_WriteMaterialDecls);
+        bool result = exportManager.ExportFiles(_ResourceIndex, _ResourceData, _ResourcePath, _StreamDBResolver, outputDirectory, filesToExport);
+
+        const std::vector<ExportTask>& exportedTasks = exportManager.GetExportJobQueue();
+        _LastExportCount = exportedTasks.size();
+        _LastExportFailureCount = std::count_if(exportedTasks.begin(), exportedTasks.end(), [](const ExportTask& task) { return !task.Result; });
+        return result;
     }
 
     bool SAMUEL::Init(const std::string resourcePath, GLOBAL_RESOURCES& globalResources)
@@ -14,6 +14,11 @@
 #include "ExportManager.h"
 #include "Oodle.h"
 #include "ResourceFileReader.h"
+#include "ResourceIndex.h"
+#include "ResourceIndexCache.h"
+#include "ResourceSearchIndex.h"
+#include "StreamDBResolver.h"
+#include "ThreadPool.h"
 #include "Utilities.h"
 
 namespace fs = std::filesystem;
@@ -33,7 +38,26 @@ namespace HAYDEN
 	    bool HasResourceLoadError() { return _HasResourceLoadError; }
 	    std::string GetLastErrorMessage() { return _LastErrorMessage; }
 	    std::string GetLastErrorDetail() { return _LastErrorDetail; }
-	    std::vector<ResourceEntry> GetResourceData() { return _ResourceData; }
+	    const std::vector<ResourceEntry>& GetResourceData() const { return _ResourceData; }
+
+	    // Number of files exported (attempted), and of those that failed, in the last ExportFiles call
+	    size_t GetLastExportCount() { return _LastExportCount; }
+	    size_t GetLastExportFailureCount() { return _LastExportFailureCount; }
+
+	    // Parsed .resources indexes are cached here. Pass an empty path to disable caching.
+	    void SetIndexCacheDirectory(const fs::path cacheDirectory) { _IndexCache.CacheDirectory = cacheDirectory; }
+
+	    // Number of threads used for exporting. 0 = one per hardware thread.
+	    void SetExportWorkerCount(const size_t workerCount) { _ExportWorkerCount = workerCount; }
+
+	    // File format for exported textures. Model textures are always PNG.
+	    void SetImageExportFormat(const ImageExportFormat imageFormat) { _ImageExportFormat = imageFormat; }
+
+	    // File format for exported models (OBJ + MTL, or a single GLB)
+	    void SetModelExportFormat(const ModelExportFormat modelFormat) { _ModelExportFormat = modelFormat; }
+
+	    // Write the material2 .decls used by exported models to <model>/material2/
+	    void SetWriteMaterialDecls(const bool writeMaterialDecls) { _WriteMaterialDecls = writeMaterialDecls; }
 
 	private:
 	    bool _HasFatalError = 0;
@@ -45,8 +69,17 @@ namespace HAYDEN
             std::string _ResourceFileName;
 	    std::vector<std::string> _StreamDBFileList;
 	    std::vector<StreamDBFile> _StreamDBFileData; 
+	    StreamDBResolver _StreamDBResolver;
 	    std::vector<ResourceEntry> _ResourceData;
 	    PackageMapSpec _PackageMapSpec;
+	    ResourceIndexCache _IndexCache;
+	    ResourceIndex _ResourceIndex;
+	    size_t _ExportWorkerCount = 0;
+	    ImageExportFormat _ImageExportFormat = ImageExportFormat::PNG;
+	    ModelExportFormat _ModelExportFormat = ModelExportFormat::OBJ;
+	    bool _WriteMaterialDecls = 1;
+	    size_t _LastExportCount = 0;
+	    size_t _LastExportFailureCount = 0;
             GLOBAL_RESOURCES* _GlobalResources;
 
 	    // Outputs to stderr, but also stores error message for passing to another application (Qt, etc).
@@ -57,10 +90,10 @@ namespace HAYDEN
 	    void LoadPackageMapSpec();
 
 	    // Loads all global *.resources (needed for LWO export)
-	    void LoadGlobalResources();
+	    void LoadGlobalResources(ThreadPool& threadPool);
 
 	    // Reads streamdb data associated with this resource file (per packageMapSpec).
 	    void UpdateStreamDBFileList(const std::string resourceFileName);
-	    void ReadStreamDBFiles();
+	    void ReadStreamDBFiles(ThreadPool& threadPool);
     };
 }
\ No newline at end of file
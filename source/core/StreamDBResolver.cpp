@@ -0,0 +1,91 @@
+#include "StreamDBResolver.h"
+
+namespace HAYDEN
+{
+    // Rebuild the index. streamDBFiles must outlive this resolver (or the next Build call).
+    void StreamDBResolver::Build(const std::vector<StreamDBFile>& streamDBFiles)
+    {
+        _StreamDBFiles = &streamDBFiles;
+        _Index.clear();
+
+        size_t numEntries = 0;
+        for (size_t i = 0; i < streamDBFiles.size(); i++)
+            numEntries += streamDBFiles[i].GetEntries().size();
+
+        _Index.reserve(numEntries);
+        for (uint32_t i = 0; i < streamDBFiles.size(); i++)
+        {
+            const std::vector<StreamDBEntry>& entries = streamDBFiles[i].GetEntries();
+            for (uint32_t j = 0; j < entries.size(); j++)
+            {
+                StreamDBResolverEntry indexEntry;
+                indexEntry.FileID = entries[j].FileID;
+                indexEntry.FileIndex = i;
+                indexEntry.EntryIndex = j;
+                _Index.push_back(indexEntry);
+            }
+        }
+
+        // Entries were added in priority order, so a stable sort keeps FileIndex/EntryIndex ordered
+        std::stable_sort(_Index.begin(), _Index.end(), [](const StreamDBResolverEntry& a, const StreamDBResolverEntry& b) {
+            return a.FileID < b.FileID;
+        });
+    }
+
+    // Locate streamed data by FileID + compressed size, honoring file priority.
+    // Entries are checked file by file, in priority order.
+    StreamDBLocation StreamDBResolver::Locate(const uint64_t streamedFileID, const uint64_t streamedDataLength) const
+    {
+        StreamDBLocation location;
+        if (_StreamDBFiles == NULL)
+            return location;
+
+        auto it = std::lower_bound(_Index.begin(), _Index.end(), streamedFileID, [](const StreamDBResolverEntry& a, const uint64_t fileID) {
+            return a.FileID < fileID;
+        });
+
+        int64_t skipFileIndex = -1;
+        for (; it != _Index.end() && it->FileID == streamedFileID; ++it)
+        {
+            // An earlier entry in this file already matched, but with no data. Move on to the next file.
+            if (it->FileIndex == skipFileIndex)
+                continue;
+
+            const std::vector<StreamDBEntry>& entries = (*_StreamDBFiles)[it->FileIndex].GetEntries();
+            const StreamDBEntry& entry = entries[it->EntryIndex];
+            const StreamDBEntry* match = NULL;
+
+            // Match
+            if (streamedDataLength == entry.CompressedSize)
+                match = &entry;
+
+            // FileID matches, but compressed size doesn't. Sometimes it will match the next entry in sequence.
+            else if (streamedDataLength < entry.CompressedSize && it->EntryIndex + 1 < entries.size() && streamedDataLength == entries[it->EntryIndex + 1].CompressedSize)
+                match = &entries[it->EntryIndex + 1];
+
+            if (match == NULL)
+                continue;
+
+            if (match->Offset16 > 0)
+            {
+                location.FileIndex = it->FileIndex;
+                location.Entry = *match;
+                return location;
+            }
+
+            skipFileIndex = it->FileIndex;
+        }
+
+        return location;
+    }
+
+    // Read the embedded file at a location returned by Locate()
+    std::vector<uint8_t> StreamDBResolver::GetEmbeddedFile(const StreamDBLocation& location) const
+    {
+        if (!location.IsValid())
+            return std::vector<uint8_t>();
+
+        const StreamDBFile& streamDBFile = GetFile(location.FileIndex);
+        return streamDBFile.GetEmbeddedFile(streamDBFile.FilePath, location.Entry);
+    }
+}
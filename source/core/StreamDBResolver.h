@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+
+#include "idFileTypes/StreamDBFile.h"
+
+namespace fs = std::filesystem;
+
+namespace HAYDEN
+{
+    // Result of a StreamDBResolver lookup
+    struct StreamDBLocation
+    {
+        int32_t FileIndex = -1;                     // index into the std::vector<StreamDBFile> the resolver was built from
+        StreamDBEntry Entry;
+        bool IsValid() const { return FileIndex >= 0; }
+    };
+
+    // Sorted lookup table entry, spanning all loaded .streamdb files
+    struct StreamDBResolverEntry
+    {
+        uint64_t FileID = 0;
+        uint32_t FileIndex = 0;
+        uint32_t EntryIndex = 0;
+    };
+
+    // Merged FileID index across all loaded .streamdb files.
+    // Files earlier in the list take priority (e.g. EternalMod.streamdb is always first when present).
+    class StreamDBResolver
+    {
+        public:
+
+            // Locate streamed data by FileID + compressed size, honoring file priority
+            StreamDBLocation Locate(const uint64_t streamedFileID, const uint64_t streamedDataLength) const;
+
+            // Read the embedded file at a location returned by Locate()
+            std::vector<uint8_t> GetEmbeddedFile(const StreamDBLocation& location) const;
+
+            const StreamDBFile& GetFile(const int32_t fileIndex) const { return (*_StreamDBFiles)[fileIndex]; }
+
+            // Rebuild the index. streamDBFiles must outlive this resolver (or the next Build call).
+            void Build(const std::vector<StreamDBFile>& streamDBFiles);
+
+        private:
+
+            const std::vector<StreamDBFile>* _StreamDBFiles = NULL;
+
+            // Sorted by FileID, then FileIndex, then EntryIndex
+            std::vector<StreamDBResolverEntry> _Index;
+    };
+}
@@ -0,0 +1,54 @@
+#include "ThreadPool.h"
+
+namespace HAYDEN
+{
+    // Returns the number of hardware threads, at least 1
+    size_t ThreadPool::GetDefaultThreadCount()
+    {
+        size_t numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0)
+            numThreads = 1;
+        return numThreads;
+    }
+
+    ThreadPool::ThreadPool(size_t numThreads)
+    {
+        if (numThreads == 0)
+            numThreads = GetDefaultThreadCount();
+
+        for (size_t i = 0; i < numThreads; i++)
+            _Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+
+    // Finishes all queued tasks before returning
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _Stopping = 1;
+        }
+        _TaskAvailable.notify_all();
+
+        for (size_t i = 0; i < _Workers.size(); i++)
+            _Workers[i].join();
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_Mutex);
+                _TaskAvailable.wait(lock, [this]() { return _Stopping || !_Tasks.empty(); });
+
+                if (_Tasks.empty())
+                    return;
+
+                task = std::move(_Tasks.front());
+                _Tasks.pop();
+            }
+            task();
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <future>
+#include <functional>
+#include <condition_variable>
+
+namespace HAYDEN
+{
+    // Fixed-size pool of worker threads. Tasks run in submission order as workers become free.
+    class ThreadPool
+    {
+        public:
+
+            size_t GetThreadCount() const { return _Workers.size(); }
+
+            // Queue a task, returns a future for its result (or exception)
+            template <typename F>
+            auto Submit(F&& task) -> std::future<decltype(task())>
+            {
+                using ResultType = decltype(task());
+                auto packagedTask = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(task));
+                std::future<ResultType> result = packagedTask->get_future();
+                {
+                    std::lock_guard<std::mutex> lock(_Mutex);
+                    _Tasks.push([packagedTask]() { (*packagedTask)(); });
+                }
+                _TaskAvailable.notify_one();
+                return result;
+            }
+
+            // Returns the number of hardware threads, at least 1
+            static size_t GetDefaultThreadCount();
+
+            // numThreads = 0 uses GetDefaultThreadCount()
+            ThreadPool(size_t numThreads = 0);
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            // Finishes all queued tasks before returning
+            ~ThreadPool();
+
+        private:
+
+            std::vector<std::thread> _Workers;
+            std::queue<std::function<void()>> _Tasks;
+            std::mutex _Mutex;
+            std::condition_variable _TaskAvailable;
+            bool _Stopping = 0;
+
+            void WorkerLoop();
+    };
+}
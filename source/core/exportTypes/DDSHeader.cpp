@@ -24,7 +24,7 @@ namespace HAYDEN
         }
         return buffer;
     }
-    DDSHeaderBuilder::DDSHeaderBuilder(int width, int height, int decompressedSize, ImageType imageType)
+    DDSHeaderBuilder::DDSHeaderBuilder(int width, int height, int decompressedSize, ImageType imageType, bool srgb)
     {
         _DDSHeader.ImgHeight = height;
         _DDSHeader.ImgWidth = width;
@@ -46,6 +46,11 @@ namespace HAYDEN
                 _DDSHeader.DDSType = 843666497;     // ATI2
                 return;
             case ImageType::FMT_BC7_SRGB:
+                _AppendDXT10 = 1;
+                _DDSHeader.DDSType = 808540228;     // DX10
+                if (srgb)
+                    _DDSHeaderDXT10.DXGIFormat = 99;    // DXGI_FORMAT_BC7_UNORM_SRGB
+                return;
             case ImageType::FMT_BC7_LINEAR:
                 _AppendDXT10 = 1;
                 _DDSHeader.DDSType = 808540228;     // DX10
@@ -67,7 +67,8 @@ namespace HAYDEN
 	public:
 	    int ComputePitch(int width, int height, int decompressedSize, ImageType imageType);
 	    std::vector<uint8_t> ConvertToByteVector();
-	    DDSHeaderBuilder(int width, int height, int decompressedSize, ImageType imageType);
+	    // srgb = 1 marks sRGB BC7 textures as DXGI_FORMAT_BC7_UNORM_SRGB. Used when writing .dds files as-is.
+	    DDSHeaderBuilder(int width, int height, int decompressedSize, ImageType imageType, bool srgb = 0);
 			
 	private:
 	    DDSHeader _DDSHeader;
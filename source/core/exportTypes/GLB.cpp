@@ -0,0 +1,311 @@
+#include "GLB.h"
+
+namespace HAYDEN
+{
+    // glTF constants
+    static constexpr int GLTF_FLOAT = 5126;
+    static constexpr int GLTF_UNSIGNED_INT = 5125;
+    static constexpr int GLTF_ARRAY_BUFFER = 34962;
+    static constexpr int GLTF_ELEMENT_ARRAY_BUFFER = 34963;
+
+    // Shortest round-trip representation, so accessor min/max match the buffer exactly
+    static std::string jsonFloat(const float value)
+    {
+        if (!std::isfinite(value))
+            return "0";
+
+        char buffer[64];
+        std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, result.ptr - buffer);
+    }
+
+    static std::string jsonString(const std::string_view str)
+    {
+        std::string out = "\"";
+        for (char c : str)
+        {
+            switch (c)
+            {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                default:
+                    if ((uint8_t)c < 0x20)
+                        out += "\\u00" + intToHex((uint8_t)c);
+                    else
+                        out += c;
+                    break;
+            }
+        }
+        return out + "\"";
+    }
+
+    // Percent-encode a relative path for use as an image URI
+    static std::string uriEncode(const std::string_view path)
+    {
+        static const char* hexDigits = "0123456789ABCDEF";
+        std::string out;
+        for (char c : path)
+        {
+            uint8_t ch = (uint8_t)c;
+            if (isalnum(ch) || c == '-' || c == '_' || c == '.' || c == '~' || c == '/')
+            {
+                out += c;
+                continue;
+            }
+            out += '%';
+            out += hexDigits[ch >> 4];
+            out += hexDigits[ch & 15];
+        }
+        return out;
+    }
+
+    static std::string getMaterialName(const std::string& materialDeclName)
+    {
+        return fs::path(materialDeclName).filename().replace_extension("").string();
+    }
+
+    // Each accessor gets its own buffer view. Returns the accessor index.
+    size_t GLBFile::AddAccessor(const void* data, const size_t size, const size_t count, const int componentType, const char* type, const int target, const float* min, const float* max)
+    {
+        // Buffer views are 4-byte aligned
+        size_t offset = _BinaryData.size();
+        _BinaryData.resize(offset + ((size + 3) & ~(size_t)3), 0);
+        memcpy(_BinaryData.data() + offset, data, size);
+
+        size_t bufferView = _NumAccessors;
+        if (!_BufferViews.empty())
+            _BufferViews += ",";
+        _BufferViews += "{\"buffer\":0,\"byteOffset\":" + std::to_string(offset) + ",\"byteLength\":" + std::to_string(size) + ",\"target\":" + std::to_string(target) + "}";
+
+        if (!_Accessors.empty())
+            _Accessors += ",";
+        _Accessors += "{\"bufferView\":" + std::to_string(bufferView) + ",\"componentType\":" + std::to_string(componentType) + ",\"count\":" + std::to_string(count) + ",\"type\":\"" + type + "\"";
+
+        if (min != NULL && max != NULL)
+        {
+            _Accessors += ",\"min\":[" + jsonFloat(min[0]) + "," + jsonFloat(min[1]) + "," + jsonFloat(min[2]) + "]";
+            _Accessors += ",\"max\":[" + jsonFloat(max[0]) + "," + jsonFloat(max[1]) + "," + jsonFloat(max[2]) + "]";
+        }
+        _Accessors += "}";
+
+        return _NumAccessors++;
+    }
+
+    bool GLBFile::WriteLWO(const LWO& lwo, const std::vector<GLBMaterial>& materials, const fs::path& outputFile)
+    {
+        return Write(lwo.Geometry, materials, outputFile);
+    }
+
+    bool GLBFile::WriteMD6(const MD6& md6, const std::vector<GLBMaterial>& materials, const fs::path& outputFile)
+    {
+        return Write(md6.Geometry, materials, outputFile);
+    }
+
+    bool GLBFile::Write(const ModelGeometry& geometry, const std::vector<GLBMaterial>& materials, const fs::path& outputFile)
+    {
+        _JSON.clear();
+        _BinaryData.clear();
+        _BufferViews.clear();
+        _Accessors.clear();
+        _NumAccessors = 0;
+
+        // Group submeshes by material, in order of first use
+        std::vector<std::string> primitiveMaterials;
+        std::vector<std::vector<size_t>> primitiveMeshes;
+        std::unordered_map<std::string, size_t> primitiveIndexes;
+
+        for (size_t i = 0; i < geometry.SubMeshes.size(); i++)
+        {
+            if (geometry.SubMeshes[i].NumVertices == 0 || geometry.SubMeshes[i].NumIndices == 0)
+                continue;
+
+            std::string mtlName = getMaterialName(geometry.SubMeshes[i].MaterialDeclName);
+            auto primitive = primitiveIndexes.emplace(mtlName, primitiveMaterials.size());
+            if (primitive.second)
+            {
+                primitiveMaterials.push_back(mtlName);
+                primitiveMeshes.emplace_back();
+            }
+            primitiveMeshes[primitive.first->second].push_back(i);
+        }
+
+        // Materials, textures and images
+        std::string materialsJSON;
+        std::string texturesJSON;
+        std::string imagesJSON;
+        size_t numTextures = 0;
+
+        auto addTexture = [&](const std::string& path) {
+            if (numTextures > 0)
+            {
+                texturesJSON += ",";
+                imagesJSON += ",";
+            }
+            texturesJSON += "{\"source\":" + std::to_string(numTextures) + "}";
+            imagesJSON += "{\"uri\":" + jsonString(uriEncode(path)) + "}";
+            return numTextures++;
+        };
+
+        for (size_t i = 0; i < primitiveMaterials.size(); i++)
+        {
+            const GLBMaterial* material = NULL;
+            for (size_t j = 0; j < materials.size(); j++)
+            {
+                if (materials[j].Name == primitiveMaterials[i])
+                {
+                    material = &materials[j];
+                    break;
+                }
+            }
+
+            if (i > 0)
+                materialsJSON += ",";
+
+            materialsJSON += "{\"name\":" + jsonString(primitiveMaterials[i]) + ",\"pbrMetallicRoughness\":{\"metallicFactor\":0";
+            if (material != NULL && !material->BaseColorTexture.empty())
+                materialsJSON += ",\"baseColorTexture\":{\"index\":" + std::to_string(addTexture(material->BaseColorTexture)) + "}";
+            materialsJSON += "}";
+
+            if (material != NULL && !material->NormalTexture.empty())
+                materialsJSON += ",\"normalTexture\":{\"index\":" + std::to_string(addTexture(material->NormalTexture)) + "}";
+            materialsJSON += "}";
+        }
+
+        // Geometry, one primitive per material
+        std::string primitivesJSON;
+        for (size_t i = 0; i < primitiveMeshes.size(); i++)
+        {
+            std::vector<float> positions;
+            std::vector<float> normals;
+            std::vector<float> uvs;
+            std::vector<uint32_t> indices;
+            float min[3] = { INFINITY, INFINITY, INFINITY };
+            float max[3] = { -INFINITY, -INFINITY, -INFINITY };
+
+            for (size_t j = 0; j < primitiveMeshes[i].size(); j++)
+            {
+                const SubMesh& subMesh = geometry.SubMeshes[primitiveMeshes[i][j]];
+                uint32_t baseVertex = (uint32_t)(positions.size() / 3);
+
+                float subMeshMin[3];
+                float subMeshMax[3];
+                if (geometry.GetBounds(subMesh.FirstVertex, subMesh.NumVertices, subMeshMin, subMeshMax))
+                {
+                    for (int c = 0; c < 3; c++)
+                    {
+                        min[c] = std::min(min[c], subMeshMin[c]);
+                        max[c] = std::max(max[c], subMeshMax[c]);
+                    }
+                }
+
+                // glTF attributes are interleaved per vertex (VEC3/VEC2)
+                size_t end = (size_t)subMesh.FirstVertex + subMesh.NumVertices;
+                for (size_t k = subMesh.FirstVertex; k < end; k++)
+                {
+                    positions.insert(positions.end(), { geometry.X[k], geometry.Y[k], geometry.Z[k] });
+
+                    // glTF requires unit length normals
+                    float normalX = geometry.NormalX[k];
+                    float normalY = geometry.NormalY[k];
+                    float normalZ = geometry.NormalZ[k];
+                    float length = std::sqrt(normalX * normalX + normalY * normalY + normalZ * normalZ);
+                    if (length > 0)
+                        normals.insert(normals.end(), { normalX / length, normalY / length, normalZ / length });
+                    else
+                        normals.insert(normals.end(), { 0, 1, 0 });
+
+                    uvs.insert(uvs.end(), { geometry.U[k], 1 - geometry.V[k] });
+                }
+
+                // Same winding as the OBJ export (F1, F3, F2). Faces referencing missing vertices are dropped.
+                const uint32_t* faces = geometry.Indices.data() + subMesh.FirstIndex;
+                for (size_t k = 0; k + 3 <= subMesh.NumIndices; k += 3)
+                {
+                    if (faces[k] >= subMesh.NumVertices || faces[k + 1] >= subMesh.NumVertices || faces[k + 2] >= subMesh.NumVertices)
+                        continue;
+
+                    indices.insert(indices.end(), { baseVertex + faces[k], baseVertex + faces[k + 2], baseVertex + faces[k + 1] });
+                }
+            }
+
+            // glTF doesn't allow empty accessors, skip materials left without geometry
+            if (positions.empty() || indices.empty())
+                continue;
+
+            size_t vertexCount = positions.size() / 3;
+            size_t positionAccessor = AddAccessor(positions.data(), positions.size() * sizeof(float), vertexCount, GLTF_FLOAT, "VEC3", GLTF_ARRAY_BUFFER, min, max);
+            size_t normalAccessor = AddAccessor(normals.data(), normals.size() * sizeof(float), vertexCount, GLTF_FLOAT, "VEC3", GLTF_ARRAY_BUFFER);
+            size_t uvAccessor = AddAccessor(uvs.data(), uvs.size() * sizeof(float), vertexCount, GLTF_FLOAT, "VEC2", GLTF_ARRAY_BUFFER);
+            size_t indexAccessor = AddAccessor(indices.data(), indices.size() * sizeof(uint32_t), indices.size(), GLTF_UNSIGNED_INT, "SCALAR", GLTF_ELEMENT_ARRAY_BUFFER);
+
+            if (!primitivesJSON.empty())
+                primitivesJSON += ",";
+
+            primitivesJSON += "{\"attributes\":{\"POSITION\":" + std::to_string(positionAccessor) + ",\"NORMAL\":" + std::to_string(normalAccessor) + ",\"TEXCOORD_0\":" + std::to_string(uvAccessor) + "}";
+            primitivesJSON += ",\"indices\":" + std::to_string(indexAccessor) + ",\"material\":" + std::to_string(i) + ",\"mode\":4}";
+        }
+
+        // Build JSON chunk
+        std::string modelName = outputFile.stem().string();
+        _JSON = "{\"asset\":{\"version\":\"2.0\",\"generator\":" + jsonString(Generator) + "}";
+
+        if (!primitivesJSON.empty())
+        {
+            _JSON += ",\"scene\":0,\"scenes\":[{\"nodes\":[0]}]";
+            _JSON += ",\"nodes\":[{\"name\":" + jsonString(modelName) + ",\"mesh\":0}]";
+            _JSON += ",\"meshes\":[{\"name\":" + jsonString(modelName) + ",\"primitives\":[" + primitivesJSON + "]}]";
+            _JSON += ",\"materials\":[" + materialsJSON + "]";
+
+            if (numTextures > 0)
+            {
+                _JSON += ",\"textures\":[" + texturesJSON + "]";
+                _JSON += ",\"images\":[" + imagesJSON + "]";
+            }
+
+            _JSON += ",\"accessors\":[" + _Accessors + "]";
+            _JSON += ",\"bufferViews\":[" + _BufferViews + "]";
+            _JSON += ",\"buffers\":[{\"byteLength\":" + std::to_string(_BinaryData.size()) + "}]";
+        }
+        _JSON += "}";
+
+        // JSON chunk is padded with spaces, BIN chunk with zeros
+        while (_JSON.size() % 4 != 0)
+            _JSON += ' ';
+
+        uint32_t jsonChunkLength = (uint32_t)_JSON.size();
+        uint32_t binChunkLength = (uint32_t)_BinaryData.size();
+        uint32_t totalLength = 12 + 8 + jsonChunkLength + (binChunkLength > 0 ? 8 + binChunkLength : 0);
+
+        std::vector<uint8_t> glbFile;
+        glbFile.reserve(totalLength);
+
+        auto writeUInt32 = [&glbFile](const uint32_t value) {
+            const uint8_t* bytes = (const uint8_t*)&value;
+            glbFile.insert(glbFile.end(), bytes, bytes + 4);
+        };
+
+        // Header
+        writeUInt32(0x46546C67);        // "glTF"
+        writeUInt32(2);
+        writeUInt32(totalLength);
+
+        // JSON chunk
+        writeUInt32(jsonChunkLength);
+        writeUInt32(0x4E4F534A);        // "JSON"
+        glbFile.insert(glbFile.end(), _JSON.begin(), _JSON.end());
+
+        // BIN chunk
+        if (binChunkLength > 0)
+        {
+            writeUInt32(binChunkLength);
+            writeUInt32(0x004E4942);    // "BIN"
+            glbFile.insert(glbFile.end(), _BinaryData.begin(), _BinaryData.end());
+        }
+
+        return writeToFilesystem(std::move(glbFile), outputFile);
+    }
+}
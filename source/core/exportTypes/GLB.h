@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <cstring>
+#include <cmath>
+#include <filesystem>
+#include <unordered_map>
+
+#include "../idFileTypes/LWO.h"
+#include "../idFileTypes/MD6.h"
+#include "../Utilities.h"
+
+namespace fs = std::filesystem;
+
+namespace HAYDEN
+{
+    /**
+    *   Notes on GLB (binary glTF 2.0) export:
+    *
+    *   One mesh, with one primitive per material. Meshes sharing a material are merged into
+    *   the same primitive. Positions, normals and UVs are stored as float vectors, indices as uint32.
+    *   UVs are flipped (V = 1 - V) since glTF puts the UV origin at the top left, unlike OBJ.
+    *   Textures are not embedded, they are referenced from the images/ folder next to the .glb file.
+    */
+
+    struct GLBMaterial
+    {
+        std::string Name;                   // material name, as in .mtl files
+        std::string BaseColorTexture;       // relative path, e.g. "images/foo.png", empty if none
+        std::string NormalTexture;
+    };
+
+    class GLBFile
+    {
+        public:
+            std::string Generator = "SAMUEL v2.1.2";
+
+            // Write the model to a GLB file. Return 1 on success.
+            bool WriteLWO(const LWO& lwo, const std::vector<GLBMaterial>& materials, const fs::path& outputFile);
+            bool WriteMD6(const MD6& md6, const std::vector<GLBMaterial>& materials, const fs::path& outputFile);
+
+            bool Write(const ModelGeometry& geometry, const std::vector<GLBMaterial>& materials, const fs::path& outputFile);
+
+        private:
+            std::string _JSON;
+            std::vector<uint8_t> _BinaryData;
+
+            // Each accessor gets its own buffer view. Returns the accessor index.
+            size_t AddAccessor(const void* data, const size_t size, const size_t count, const int componentType, const char* type, const int target, const float* min = NULL, const float* max = NULL);
+            std::string _BufferViews;
+            std::string _Accessors;
+            size_t _NumAccessors = 0;
+    };
+}
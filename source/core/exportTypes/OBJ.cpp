@@ -2,295 +2,213 @@
 
 namespace HAYDEN
 {
-    void OBJFile::ConvertFromLWO(LWO& lwo)
+    OBJStreamWriter::OBJStreamWriter()
     {
-        uint64_t vertexCount = 0;
-        Objects.resize(lwo.Header.Metadata.NumMeshes);
-
-        for (uint64_t i = 0; i < Objects.size(); i++)
-        {
-            // construct material name
-            fs::path mtlPath = lwo.Header.MeshInfo[i].MaterialDeclName;
-            std::string mtlName = mtlPath.filename().replace_extension("").string();
-
-            // set object name, group name, and usemtl (based on material name)
-            Objects[i].ObjectName = "o " + mtlName;
-            Objects[i].GroupLine = "g " + mtlName;
-            Objects[i].UseMaterialLine = "usemtl " + mtlName;
-
-            // build vert strings
-            for (uint64_t j = 0; j < lwo.MeshGeometry[i].Vertices.size(); j++)
-            {
-                std::stringstream x;
-                std::stringstream y;
-                std::stringstream z;
-
-                x << std::fixed << std::setprecision(8) << lwo.MeshGeometry[i].Vertices[j].X;
-                y << std::fixed << std::setprecision(8) << lwo.MeshGeometry[i].Vertices[j].Y;
-                z << std::fixed << std::setprecision(8) << lwo.MeshGeometry[i].Vertices[j].Z;
-
-                std::string str = ("v " + x.str() + " " + y.str() + " " + z.str());
-                Objects[i].Vertices.push_back(str);
-            }
-
-            // build UV strings
-            for (uint64_t j = 0; j < lwo.MeshGeometry[i].UVs.size(); j++)
-            {
-                std::stringstream u;
-                std::stringstream v;
-
-                u << std::fixed << std::setprecision(8) << lwo.MeshGeometry[i].UVs[j].U;
-                v << std::fixed << std::setprecision(8) << lwo.MeshGeometry[i].UVs[j].V;
-
-                std::string str = ("vt " + u.str() + " " + v.str());
-                Objects[i].UVs.push_back(str);
-            }
+        _Buffer.resize(_BufferSize);
+    }
 
-            // build Normal strings
-            for (uint64_t j = 0; j < lwo.MeshGeometry[i].Normals.size(); j++)
-            {
-                std::stringstream xn;
-                std::stringstream yn;
-                std::stringstream zn;
+    bool OBJStreamWriter::Open(const fs::path& outputFile)
+    {
+        Close();
+        _File.open(outputFile.string(), std::ios::out);
+        return _File.is_open();
+    }
 
-                xn << std::fixed << std::setprecision(8) << lwo.MeshGeometry[i].Normals[j].Xn;
-                yn << std::fixed << std::setprecision(8) << lwo.MeshGeometry[i].Normals[j].Yn;
-                zn << std::fixed << std::setprecision(8) << lwo.MeshGeometry[i].Normals[j].Zn;
+    void OBJStreamWriter::Close()
+    {
+        if (!_File.is_open())
+            return;
 
-                std::string str = ("vn " + xn.str() + " " + yn.str() + " " + zn.str());
-                Objects[i].Normals.push_back(str);
-            }
+        Flush();
+        _File.close();
+    }
 
-            // build Face strings
-            uint64_t offset = 1;
+    void OBJStreamWriter::Flush()
+    {
+        _File.write(_Buffer.data(), _BufferUsed);
+        _BufferUsed = 0;
+    }
 
-            if (i > 0)
-            {
-                // offset the face index by the number of vertices that came before it
-                vertexCount += lwo.MeshGeometry[i - 1].Vertices.size();
-                offset = vertexCount + 1;
-            }
+    void OBJStreamWriter::Write(const std::string_view text)
+    {
+        if (_BufferSize - _BufferUsed < text.size())
+        {
+            Flush();
 
-            for (uint64_t j = 0; j < lwo.MeshGeometry[i].Faces.size(); j++)
+            // Too big for the buffer, write directly
+            if (text.size() > _BufferSize)
             {
-                std::string f1 = std::to_string(lwo.MeshGeometry[i].Faces[j].F1 + offset);
-                std::string f2 = std::to_string(lwo.MeshGeometry[i].Faces[j].F2 + offset);
-                std::string f3 = std::to_string(lwo.MeshGeometry[i].Faces[j].F3 + offset);
-
-                f1 = "f " + f1 + "/" + f1 + "/" + f1;
-                f2 =  " " + f2 + "/" + f2 + "/" + f2;
-                f3 =  " " + f3 + "/" + f3 + "/" + f3;
-
-                // f3 comes before f2, otherwise the faces are inverted in Blender
-                std::string str = f1 + f3 + f2;
-                Objects[i].Faces.push_back(str);
+                _File.write(text.data(), text.size());
+                return;
             }
         }
-
-        return;
+        std::copy(text.begin(), text.end(), _Buffer.data() + _BufferUsed);
+        _BufferUsed += text.size();
     }
 
-    void OBJFile::ConvertFromMD6(MD6& md6)
+    // Same output as std::fixed << std::setprecision(8)
+    void OBJStreamWriter::WriteFloat(const float_t value)
     {
-        uint64_t vertexCount = 0;
-        Objects.resize(md6.Header.NumMeshes);
-        FaceMaterialGroups.resize(md6.Header.NumMeshes);
-
-        for (uint64_t i = 0; i < Objects.size(); i++)
-        {
-            // For alternate config where original mesh names are retained
-            // Objects[i].ObjectName = "o " + md6.Header.MeshInfo[i].MeshName;
+        Reserve();
+        std::to_chars_result result = std::to_chars(_Buffer.data() + _BufferUsed, _Buffer.data() + _BufferSize, value, std::chars_format::fixed, 8);
+        _BufferUsed = result.ptr - _Buffer.data();
+    }
 
-            // construct material name
-            fs::path mtlPath = md6.Header.MeshInfo[i].MaterialDeclName;
-            std::string mtlName = mtlPath.filename().replace_extension("").string();
+    void OBJStreamWriter::WriteUInt(const uint64_t value)
+    {
+        Reserve();
+        std::to_chars_result result = std::to_chars(_Buffer.data() + _BufferUsed, _Buffer.data() + _BufferSize, value);
+        _BufferUsed = result.ptr - _Buffer.data();
+    }
 
-            // set object name, group name, and usemtl (based on material name)
-            Objects[i].ObjectName = "o " + mtlName;
-            Objects[i].GroupLine = "g " + mtlName;
-            Objects[i].UseMaterialLine = "usemtl " + mtlName;
+    void OBJStreamWriter::WriteVertex(const float_t x, const float_t y, const float_t z)
+    {
+        Write("v ");
+        WriteFloat(x);
+        Write(" ");
+        WriteFloat(y);
+        Write(" ");
+        WriteFloat(z);
+        Write("\n");
+    }
 
-            // build Vert strings
-            for (uint64_t j = 0; j < md6.MeshGeometry[i].Vertices.size(); j++)
-            {
-                std::stringstream x;
-                std::stringstream y;
-                std::stringstream z;
+    void OBJStreamWriter::WriteNormal(const float_t x, const float_t y, const float_t z)
+    {
+        Write("vn ");
+        WriteFloat(x);
+        Write(" ");
+        WriteFloat(y);
+        Write(" ");
+        WriteFloat(z);
+        Write("\n");
+    }
 
-                x << std::fixed << std::setprecision(8) << md6.MeshGeometry[i].Vertices[j].X;
-                y << std::fixed << std::setprecision(8) << md6.MeshGeometry[i].Vertices[j].Y;
-                z << std::fixed << std::setprecision(8) << md6.MeshGeometry[i].Vertices[j].Z;
+    void OBJStreamWriter::WriteUV(const float_t u, const float_t v)
+    {
+        Write("vt ");
+        WriteFloat(u);
+        Write(" ");
+        WriteFloat(v);
+        Write("\n");
+    }
 
-                std::string str = ("v " + x.str() + " " + y.str() + " " + z.str());
-                Objects[i].Vertices.push_back(str);
-            }
+    // Writes "f a/a/a c/c/c b/b/b" for indices (a, b, c). c comes before b, otherwise the faces are inverted in Blender
+    void OBJStreamWriter::WriteFace(const uint32_t* indices, const uint64_t offset)
+    {
+        uint64_t objIndices[3] = { indices[0] + offset, indices[2] + offset, indices[1] + offset };
 
-            // build UV strings
-            for (uint64_t j = 0; j < md6.MeshGeometry[i].UVs.size(); j++)
-            {
-                std::stringstream u;
-                std::stringstream v;
+        Write("f");
+        for (int i = 0; i < 3; i++)
+        {
+            Write(" ");
+            WriteUInt(objIndices[i]);
+            Write("/");
+            WriteUInt(objIndices[i]);
+            Write("/");
+            WriteUInt(objIndices[i]);
+        }
+        Write("\n");
+    }
 
-                u << std::fixed << std::setprecision(8) << md6.MeshGeometry[i].UVs[j].U;
-                v << std::fixed << std::setprecision(8) << md6.MeshGeometry[i].UVs[j].V;
+    // Material name as used in .mtl files: decl file name without extension
+    std::string OBJFile::GetMaterialName(const std::string& materialDeclName)
+    {
+        return fs::path(materialDeclName).filename().replace_extension("").string();
+    }
 
-                std::string str = ("vt " + u.str() + " " + v.str());
-                Objects[i].UVs.push_back(str);
-            }
+    void OBJFile::WriteHeader(OBJStreamWriter& writer, const std::string& materialLibrary)
+    {
+        writer.Write(SignatureLine);
+        writer.Write("\n\n");
+        writer.Write("mtllib " + materialLibrary + "\n\n");
+    }
 
-            // build Normal strings
-            for (uint64_t j = 0; j < md6.MeshGeometry[i].Normals.size(); j++)
-            {
-                std::stringstream xn;
-                std::stringstream yn;
-                std::stringstream zn;
+    void OBJFile::WriteMeshVertices(OBJStreamWriter& writer, const ModelGeometry& geometry, const SubMesh& subMesh)
+    {
+        size_t end = (size_t)subMesh.FirstVertex + subMesh.NumVertices;
 
-                xn << std::fixed << std::setprecision(8) << md6.MeshGeometry[i].Normals[j].Xn;
-                yn << std::fixed << std::setprecision(8) << md6.MeshGeometry[i].Normals[j].Yn;
-                zn << std::fixed << std::setprecision(8) << md6.MeshGeometry[i].Normals[j].Zn;
+        for (size_t j = subMesh.FirstVertex; j < end; j++)
+            writer.WriteVertex(geometry.X[j], geometry.Y[j], geometry.Z[j]);
 
-                std::string str = ("vn " + xn.str() + " " + yn.str() + " " + zn.str());
-                Objects[i].Normals.push_back(str);
-            }
+        for (size_t j = subMesh.FirstVertex; j < end; j++)
+            writer.WriteUV(geometry.U[j], geometry.V[j]);
 
-            // build Face strings
-            uint64_t offset = 1;
+        for (size_t j = subMesh.FirstVertex; j < end; j++)
+            writer.WriteNormal(geometry.NormalX[j], geometry.NormalY[j], geometry.NormalZ[j]);
+    }
 
-            if (i > 0)
-            {
-                // offset the face index by the number of vertices that came before it
-                vertexCount += md6.MeshGeometry[i - 1].Vertices.size();
-                offset = vertexCount + 1;
-            }
+    // OBJ indices are global and 1-based, submesh indices are relative to its first vertex
+    void OBJFile::WriteMeshFaces(OBJStreamWriter& writer, const ModelGeometry& geometry, const SubMesh& subMesh)
+    {
+        size_t end = (size_t)subMesh.FirstIndex + subMesh.NumIndices;
 
-            for (uint64_t j = 0; j < md6.MeshGeometry[i].Faces.size(); j++)
-            {
-                std::string f1 = std::to_string(md6.MeshGeometry[i].Faces[j].F1 + offset);
-                std::string f2 = std::to_string(md6.MeshGeometry[i].Faces[j].F2 + offset);
-                std::string f3 = std::to_string(md6.MeshGeometry[i].Faces[j].F3 + offset);
+        for (size_t j = subMesh.FirstIndex; j + 3 <= end; j += 3)
+            writer.WriteFace(geometry.Indices.data() + j, (uint64_t)subMesh.FirstVertex + 1);
+    }
 
-                f1 = "f " + f1 + "/" + f1 + "/" + f1;
-                f2 = " " + f2 + "/" + f2 + "/" + f2;
-                f3 = " " + f3 + "/" + f3 + "/" + f3;
+    // LWO: one object per mesh, each followed by its own faces
+    bool OBJFile::WriteLWO(const LWO& lwo, const fs::path& outputFile, const std::string& materialLibrary)
+    {
+        OBJStreamWriter writer;
+        if (!writer.Open(outputFile))
+            return 0;
 
-                // f3 comes before f2, otherwise the faces are inverted in Blender
-                std::string str = f1 + f3 + f2;
-                Objects[i].Faces.push_back(str);
-            }
+        WriteHeader(writer, materialLibrary);
 
-            // Build face material groups
-            FaceMaterialGroups[i].GroupLine = Objects[i].GroupLine;
-            FaceMaterialGroups[i].UseMaterialLine = Objects[i].UseMaterialLine;
-            FaceMaterialGroups[i].Faces = Objects[i].Faces;
+        for (size_t i = 0; i < lwo.Geometry.SubMeshes.size(); i++)
+        {
+            const SubMesh& subMesh = lwo.Geometry.SubMeshes[i];
+            std::string mtlName = GetMaterialName(subMesh.MaterialDeclName);
+
+            writer.Write("o " + mtlName + "\n");
+            WriteMeshVertices(writer, lwo.Geometry, subMesh);
+            writer.Write("g " + mtlName + "\n");
+            writer.Write("usemtl " + mtlName + "\n");
+            WriteMeshFaces(writer, lwo.Geometry, subMesh);
         }
-
-        // Sort face material groups alphabetically by material name
-        std::sort(FaceMaterialGroups.begin(), FaceMaterialGroups.end(), [](const OBJFile_FaceMaterialGroup& a, const OBJFile_FaceMaterialGroup& b) {
-            return (a.GroupLine < b.GroupLine);
-        });
-
-        return;
+        return 1;
     }
 
-    void OBJFile::Serialize(const std::vector<Mesh> streamedGeometry, const std::vector<std::string> meshNames, const int modelType, const int numVertices, const int numFaces, const GEO_FLAGS geoFlags, const GEO_METADATA geoMeta)
+    // MD6: all vertex data first, then faces grouped by material
+    bool OBJFile::WriteMD6(const MD6& md6, const fs::path& outputFile, const std::string& materialLibrary)
     {
-        uint64_t vertexCount = 0;
-        Objects.resize(streamedGeometry.size());
-        FaceMaterialGroups.resize(streamedGeometry.size());
-
-        for (uint64_t i = 0; i < Objects.size(); i++)
-        {
-            // For alternate config where original mesh names are retained
-            // Objects[i].ObjectName = "o " + md6.Header.MeshInfo[i].MeshName;
-
-            // construct material name
-            fs::path mtlPath = meshNames[i];
-            std::string mtlName = mtlPath.filename().replace_extension("").string();
+        OBJStreamWriter writer;
+        if (!writer.Open(outputFile))
+            return 0;
 
-            // set object name, group name, and usemtl (based on material name)
-            Objects[i].ObjectName = "o " + mtlName;
-            Objects[i].GroupLine = "g " + mtlName;
-            Objects[i].UseMaterialLine = "usemtl " + mtlName;
+        WriteHeader(writer, materialLibrary);
 
-            // build Vert strings
-            for (uint64_t j = 0; j < streamedGeometry[i].Vertices.size(); j++)
-            {
-                std::stringstream x;
-                std::stringstream y;
-                std::stringstream z;
-
-                x << std::fixed << std::setprecision(8) << streamedGeometry[i].Vertices[j].X;
-                y << std::fixed << std::setprecision(8) << streamedGeometry[i].Vertices[j].Y;
-                z << std::fixed << std::setprecision(8) << streamedGeometry[i].Vertices[j].Z;
-
-                std::string str = ("v " + x.str() + " " + y.str() + " " + z.str());
-                Objects[i].Vertices.push_back(str);
-            }
-
-            // build UV strings
-            for (uint64_t j = 0; j < streamedGeometry[i].UVs.size(); j++)
-            {
-                std::stringstream u;
-                std::stringstream v;
+        const std::vector<SubMesh>& subMeshes = md6.Geometry.SubMeshes;
+        size_t numMeshes = subMeshes.size();
+        std::vector<std::string> mtlNames(numMeshes);
 
-                u << std::fixed << std::setprecision(8) << streamedGeometry[i].UVs[j].U;
-                v << std::fixed << std::setprecision(8) << streamedGeometry[i].UVs[j].V;
-
-                std::string str = ("vt " + u.str() + " " + v.str());
-                Objects[i].UVs.push_back(str);
-            }
-
-            // build Normal strings
-            for (uint64_t j = 0; j < streamedGeometry[i].Normals.size(); j++)
-            {
-                std::stringstream xn;
-                std::stringstream yn;
-                std::stringstream zn;
-
-                xn << std::fixed << std::setprecision(8) << streamedGeometry[i].Normals[j].Xn;
-                yn << std::fixed << std::setprecision(8) << streamedGeometry[i].Normals[j].Yn;
-                zn << std::fixed << std::setprecision(8) << streamedGeometry[i].Normals[j].Zn;
+        for (size_t i = 0; i < numMeshes; i++)
+        {
+            mtlNames[i] = GetMaterialName(subMeshes[i].MaterialDeclName);
+            WriteMeshVertices(writer, md6.Geometry, subMeshes[i]);
+        }
 
-                std::string str = ("vn " + xn.str() + " " + yn.str() + " " + zn.str());
-                Objects[i].Normals.push_back(str);
-            }
+        // Sort meshes alphabetically by material name
+        std::vector<size_t> meshOrder(numMeshes);
+        for (size_t i = 0; i < numMeshes; i++)
+            meshOrder[i] = i;
 
-            // build Face strings
-            uint64_t offset = 1;
+        std::sort(meshOrder.begin(), meshOrder.end(), [&mtlNames](const size_t a, const size_t b) {
+            return mtlNames[a] < mtlNames[b];
+        });
 
-            if (i > 0)
-            {
-                // offset the face index by the number of vertices that came before it
-                vertexCount += streamedGeometry[i - 1].Vertices.size();
-                offset = vertexCount + 1;
-            }
+        for (size_t i = 0; i < numMeshes; i++)
+        {
+            size_t mesh = meshOrder[i];
 
-            for (uint64_t j = 0; j < streamedGeometry[i].Faces.size(); j++)
+            // print usemtls ONLY if not a duplicate of previous (works because they are sorted alphabetically)
+            if (i == 0 || mtlNames[mesh] != mtlNames[meshOrder[i - 1]])
             {
-                std::string f1 = std::to_string(streamedGeometry[i].Faces[j].F1 + offset);
-                std::string f2 = std::to_string(streamedGeometry[i].Faces[j].F2 + offset);
-                std::string f3 = std::to_string(streamedGeometry[i].Faces[j].F3 + offset);
-
-                f1 = "f " + f1 + "/" + f1 + "/" + f1;
-                f2 = " " + f2 + "/" + f2 + "/" + f2;
-                f3 = " " + f3 + "/" + f3 + "/" + f3;
-
-                // f3 comes before f2, otherwise the faces are inverted in Blender
-                std::string str = f1 + f3 + f2;
-                Objects[i].Faces.push_back(str);
+                writer.Write("g " + mtlNames[mesh] + "\n");
+                writer.Write("usemtl " + mtlNames[mesh] + "\n");
             }
-
-            // Build face material groups
-            FaceMaterialGroups[i].GroupLine = Objects[i].GroupLine;
-            FaceMaterialGroups[i].UseMaterialLine = Objects[i].UseMaterialLine;
-            FaceMaterialGroups[i].Faces = Objects[i].Faces;
+            WriteMeshFaces(writer, md6.Geometry, subMeshes[mesh]);
         }
-
-        // Sort face material groups alphabetically by material name
-        std::sort(FaceMaterialGroups.begin(), FaceMaterialGroups.end(), [](const OBJFile_FaceMaterialGroup& a, const OBJFile_FaceMaterialGroup& b) {
-            return (a.GroupLine < b.GroupLine);
-            });
-
-        return;
+        return 1;
     }
-}
\ No newline at end of file
+}
@@ -1,9 +1,10 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <iomanip>
-#include <sstream>
+#include <charconv>
+#include <fstream>
 #include <filesystem>
 #include <algorithm>
 
@@ -14,36 +15,52 @@ namespace fs = std::filesystem;
 
 namespace HAYDEN
 {
-    // Testing mesh merge based on material usage
-    struct OBJFile_FaceMaterialGroup
+    // Buffered text output for OBJ files. Numbers are formatted with std::to_chars straight
+    // into a reusable buffer, which is written to the file in large chunks.
+    class OBJStreamWriter
     {
-        std::string GroupLine;
-        std::string UseMaterialLine;
-        std::vector<std::string> Faces;
-    };
+        public:
 
-    struct OBJFile_Object
-    {
-	std::string ObjectName;
-	std::vector<std::string> Vertices;
-	std::vector<std::string> Normals;
-	std::vector<std::string> UVs;
+            bool Open(const fs::path& outputFile);
+            void Close();
+
+            void Write(const std::string_view text);
+            void WriteFloat(const float_t value);            // fixed, 8 decimals
+            void WriteUInt(const uint64_t value);
+            void WriteVertex(const float_t x, const float_t y, const float_t z);
+            void WriteNormal(const float_t x, const float_t y, const float_t z);
+            void WriteUV(const float_t u, const float_t v);
+            void WriteFace(const uint32_t* indices, const uint64_t offset);
+
+            OBJStreamWriter();
+            ~OBJStreamWriter() { Close(); }
 
-        std::string GroupLine;
-        std::string UseMaterialLine;     
-	std::vector<std::string> Faces;
+        private:
 
+            static constexpr size_t _BufferSize = 1 << 20;
+            static constexpr size_t _MaxLineSize = 256;      // longest line written without checking for space
+
+            std::ofstream _File;
+            std::vector<char> _Buffer;
+            size_t _BufferUsed = 0;
+
+            void Flush();
+            void Reserve() { if (_BufferSize - _BufferUsed < _MaxLineSize) Flush(); }
     };
 
     class OBJFile
     {
 	public:
             std::string SignatureLine = "# Exported with SAMUEL v2.1.2 by SamPT \n# https://github.com/brongo/SAMUEL";
-            std::string MaterialLibrary;
-	    std::vector<OBJFile_Object> Objects;
-            std::vector<OBJFile_FaceMaterialGroup> FaceMaterialGroups;
-            void ConvertFromLWO(LWO& lwo);
-            void ConvertFromMD6(MD6& md6);
-            void Serialize(const std::vector<Mesh> streamedGeometry, const std::vector<std::string> meshNames, const int modelType, const int numVertices, const int numFaces, const GEO_FLAGS geoFlags, const GEO_METADATA geoMeta);
+
+            // Write the model to an OBJ file, referencing materials from materialLibrary (.mtl file name). Return 1 on success.
+            bool WriteLWO(const LWO& lwo, const fs::path& outputFile, const std::string& materialLibrary);
+            bool WriteMD6(const MD6& md6, const fs::path& outputFile, const std::string& materialLibrary);
+
+	private:
+            static std::string GetMaterialName(const std::string& materialDeclName);
+            void WriteHeader(OBJStreamWriter& writer, const std::string& materialLibrary);
+            void WriteMeshVertices(OBJStreamWriter& writer, const ModelGeometry& geometry, const SubMesh& subMesh);
+            void WriteMeshFaces(OBJStreamWriter& writer, const ModelGeometry& geometry, const SubMesh& subMesh);
     };
 }
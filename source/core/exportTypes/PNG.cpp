@@ -2,8 +2,202 @@
 
 namespace HAYDEN
 {
+#ifndef _WIN32
+    static constexpr uint32_t makeFourCC(const char a, const char b, const char c, const char d)
+    {
+        return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) | ((uint32_t)(uint8_t)d << 24);
+    }
+
+    // Maps the DDS pixel format to a detex texture format, same formats as detexLoadDDSFile. Return 0 if not supported.
+    static bool getDetexTextureFormat(const std::vector<uint8_t>& inputDDS, uint32_t& textureFormat, size_t& dataOffset)
+    {
+        uint32_t pfFlags = *(uint32_t*)(inputDDS.data() + 80);
+        uint32_t fourCC = *(uint32_t*)(inputDDS.data() + 84);
+        dataOffset = 128;
+
+        // Uncompressed: 8-bit alpha and 16-bit luminance + alpha (RG8). RGBA8 is handled by the caller.
+        if ((pfFlags & 4) == 0)
+        {
+            uint32_t rgbBits = *(uint32_t*)(inputDDS.data() + 88);
+            uint32_t aBitMask = *(uint32_t*)(inputDDS.data() + 104);
+            if ((pfFlags & 2) != 0 && rgbBits == 8 && aBitMask == 0xFF)
+            {
+                textureFormat = DETEX_PIXEL_FORMAT_A8;
+                return 1;
+            }
+            if ((pfFlags & 0x20000) != 0 && rgbBits == 16)
+            {
+                textureFormat = DETEX_PIXEL_FORMAT_RG8;
+                return 1;
+            }
+            return 0;
+        }
+
+        switch (fourCC)
+        {
+            case makeFourCC('D', 'X', 'T', '1'):
+                textureFormat = DETEX_TEXTURE_FORMAT_BC1;
+                return 1;
+            case makeFourCC('D', 'X', 'T', '3'):
+                textureFormat = DETEX_TEXTURE_FORMAT_BC2;
+                return 1;
+            case makeFourCC('D', 'X', 'T', '5'):
+                textureFormat = DETEX_TEXTURE_FORMAT_BC3;
+                return 1;
+            case makeFourCC('A', 'T', 'I', '1'):
+            case makeFourCC('B', 'C', '4', 'U'):
+                textureFormat = DETEX_TEXTURE_FORMAT_RGTC1;
+                return 1;
+            case makeFourCC('B', 'C', '4', 'S'):
+                textureFormat = DETEX_TEXTURE_FORMAT_SIGNED_RGTC1;
+                return 1;
+            case makeFourCC('A', 'T', 'I', '2'):
+            case makeFourCC('B', 'C', '5', 'U'):
+                textureFormat = DETEX_TEXTURE_FORMAT_RGTC2;
+                return 1;
+            case makeFourCC('B', 'C', '5', 'S'):
+                textureFormat = DETEX_TEXTURE_FORMAT_SIGNED_RGTC2;
+                return 1;
+            case makeFourCC('D', 'X', '1', '0'):
+                break;
+            default:
+                return 0;
+        }
+
+        // DX10 extended header follows the DDS header
+        if (inputDDS.size() < 148)
+            return 0;
+
+        dataOffset = 148;
+        uint32_t dxgiFormat = *(uint32_t*)(inputDDS.data() + 128);
+        switch (dxgiFormat)
+        {
+            case 71:    // DXGI_FORMAT_BC1_UNORM
+            case 72:    // DXGI_FORMAT_BC1_UNORM_SRGB
+                textureFormat = DETEX_TEXTURE_FORMAT_BC1;
+                return 1;
+            case 74:    // DXGI_FORMAT_BC2_UNORM
+            case 75:    // DXGI_FORMAT_BC2_UNORM_SRGB
+                textureFormat = DETEX_TEXTURE_FORMAT_BC2;
+                return 1;
+            case 77:    // DXGI_FORMAT_BC3_UNORM
+            case 78:    // DXGI_FORMAT_BC3_UNORM_SRGB
+                textureFormat = DETEX_TEXTURE_FORMAT_BC3;
+                return 1;
+            case 80:    // DXGI_FORMAT_BC4_UNORM
+                textureFormat = DETEX_TEXTURE_FORMAT_RGTC1;
+                return 1;
+            case 81:    // DXGI_FORMAT_BC4_SNORM
+                textureFormat = DETEX_TEXTURE_FORMAT_SIGNED_RGTC1;
+                return 1;
+            case 83:    // DXGI_FORMAT_BC5_UNORM
+                textureFormat = DETEX_TEXTURE_FORMAT_RGTC2;
+                return 1;
+            case 84:    // DXGI_FORMAT_BC5_SNORM
+                textureFormat = DETEX_TEXTURE_FORMAT_SIGNED_RGTC2;
+                return 1;
+            case 95:    // DXGI_FORMAT_BC6H_UF16
+                textureFormat = DETEX_TEXTURE_FORMAT_BPTC_FLOAT;
+                return 1;
+            case 96:    // DXGI_FORMAT_BC6H_SF16
+                textureFormat = DETEX_TEXTURE_FORMAT_BPTC_SIGNED_FLOAT;
+                return 1;
+            case 98:    // DXGI_FORMAT_BC7_UNORM
+            case 99:    // DXGI_FORMAT_BC7_UNORM_SRGB
+                textureFormat = DETEX_TEXTURE_FORMAT_BPTC;
+                return 1;
+            default:
+                return 0;
+        }
+    }
+
+    // Reads the first mip of an in-memory DDS file into a detex texture, without copying the image data.
+    // Return 0 if detex can't decode this format.
+    bool PNGFile::ReadDDSTexture(const std::vector<uint8_t>& inputDDS, detexTexture& texture)
+    {
+        if (inputDDS.size() < 128 || *(uint32_t*)inputDDS.data() != makeFourCC('D', 'D', 'S', ' '))
+            return 0;
+
+        size_t dataOffset = 0;
+        if (!getDetexTextureFormat(inputDDS, texture.format, dataOffset))
+            return 0;
+
+        texture.height = *(int*)(inputDDS.data() + 12);
+        texture.width = *(int*)(inputDDS.data() + 16);
+        if (texture.width <= 0 || texture.height <= 0)
+            return 0;
+
+        // Compressed formats are stored in 4x4 blocks
+        uint64_t dataSize = 0;
+        if (detexFormatIsCompressed(texture.format))
+        {
+            texture.width_in_blocks = (texture.width + 3) / 4;
+            texture.height_in_blocks = (texture.height + 3) / 4;
+            dataSize = (uint64_t)texture.width_in_blocks * texture.height_in_blocks * detexGetCompressedBlockSize(texture.format);
+        }
+        else
+        {
+            texture.width_in_blocks = texture.width;
+            texture.height_in_blocks = texture.height;
+            dataSize = (uint64_t)texture.width * texture.height * detexGetPixelSize(texture.format);
+        }
+
+        if (inputDDS.size() - dataOffset < dataSize)
+            return 0;
+
+        texture.data = (uint8_t*)inputDDS.data() + dataOffset;
+        return 1;
+    }
+
+    // libpng write callback, appends to the output vector
+    static void writePNGData(png_structp png, png_bytep data, png_size_t length)
+    {
+        std::vector<uint8_t>* outputPNG = (std::vector<uint8_t>*)png_get_io_ptr(png);
+        outputPNG->insert(outputPNG->end(), data, data + length);
+    }
+
+    // Encodes an RGBA8 texture as PNG, into memory. Return 1 on success.
+    bool PNGFile::EncodePNG(const detexTexture& texture, std::vector<uint8_t>& outputPNG)
+    {
+        png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+        if (png == NULL)
+            return 0;
+
+        png_infop info = png_create_info_struct(png);
+        if (info == NULL)
+        {
+            png_destroy_write_struct(&png, NULL);
+            return 0;
+        }
+
+        // libpng reports errors with longjmp
+        if (setjmp(png_jmpbuf(png)))
+        {
+            png_destroy_write_struct(&png, &info);
+            outputPNG.clear();
+            return 0;
+        }
+
+        // Compressed output is usually well under the raw image size
+        outputPNG.clear();
+        outputPNG.reserve((size_t)texture.width * texture.height);
+        png_set_write_fn(png, &outputPNG, writePNGData, NULL);
+
+        png_set_IHDR(png, info, texture.width, texture.height, 8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+        png_write_info(png, info);
+
+        size_t rowSize = (size_t)texture.width * detexGetPixelSize(DETEX_PIXEL_FORMAT_RGBA8);
+        for (int y = 0; y < texture.height; y++)
+            png_write_row(png, texture.data + y * rowSize);
+
+        png_write_end(png, NULL);
+        png_destroy_write_struct(&png, &info);
+        return 1;
+    }
+#endif
+
     // Convert DDS file to PNG (using DirectXTex on Windows, else use Detex library)
-    std::vector<uint8_t> PNGFile::ConvertDDStoPNG(std::vector<uint8_t> inputDDS, bool reconstructZ)
+    std::vector<uint8_t> PNGFile::ConvertDDStoPNG(const std::vector<uint8_t>& inputDDS, bool reconstructZ)
     {
         std::vector<uint8_t> outputPNG;
 
@@ -96,62 +290,51 @@ namespace HAYDEN
         std::copy(p, p + n, std::back_inserter(outputPNG));
 
 #else
-        // Non-Windows systems use the Detex library to convert a DDS file to PNG format
-        bool failed = 0;
-        fs::path fullPath = fs::temp_directory_path() / "samuel.tmp";
-
-        FILE* outFile = fopen(fullPath.string().c_str(), "wb");
-        fwrite(inputDDS.data(), 1, inputDDS.size(), outFile);
-        fclose(outFile);
-
-        // Load DDS file
+        // Non-Windows systems use the Detex library to decompress the DDS image and libpng to encode it, all in memory
+        detexTexture ddsTexture;
         detexTexture pngTexture;
         pngTexture.format = DETEX_PIXEL_FORMAT_RGBA8;
-        detexTexture* ddsTexture = NULL;
-        std::unique_ptr<uint8_t> pngData;
+        std::vector<uint8_t> pngData;
 
-        if (!detexLoadDDSFile(fullPath.c_str(), &ddsTexture))
+        if (!ReadDDSTexture(inputDDS, ddsTexture))
         {
             // Try loading as raw (for rgba8 textures)
+            if (inputDDS.size() < 128)
+                return outputPNG;
+
             pngTexture.width = *(int*)(inputDDS.data() + 12);
             pngTexture.height = *(int*)(inputDDS.data() + 16);
             pngTexture.width_in_blocks = pngTexture.width;
             pngTexture.height_in_blocks = pngTexture.height;
-            pngTexture.data = inputDDS.data() + 128;
+
+            if (inputDDS.size() - 128 < (uint64_t)detexGetPixelSize(pngTexture.format) * pngTexture.width * pngTexture.height)
+            {
+                fprintf(stderr, "ERROR: DDS file is too small for its dimensions. \n");
+                return outputPNG;
+            }
+            pngTexture.data = (uint8_t*)inputDDS.data() + 128;
         }
         else
         {
             // Create output PNG 
-            pngTexture.width = ddsTexture->width;
-            pngTexture.height = ddsTexture->height;
-            pngTexture.width_in_blocks = ddsTexture->width;
-            pngTexture.height_in_blocks = ddsTexture->height;
-            pngData.reset(new uint8_t[detexGetPixelSize(pngTexture.format) * pngTexture.width * pngTexture.height]);
-            pngTexture.data = pngData.get();
+            pngTexture.width = ddsTexture.width;
+            pngTexture.height = ddsTexture.height;
+            pngTexture.width_in_blocks = ddsTexture.width;
+            pngTexture.height_in_blocks = ddsTexture.height;
+            pngData.resize((size_t)detexGetPixelSize(pngTexture.format) * pngTexture.width * pngTexture.height);
+            pngTexture.data = pngData.data();
 
             // Decompress DDS
-            if (!detexDecompressTextureLinear(ddsTexture, pngTexture.data, DETEX_PIXEL_FORMAT_RGBA8))
+            if (!detexDecompressTextureLinear(&ddsTexture, pngTexture.data, DETEX_PIXEL_FORMAT_RGBA8))
             {
                 fprintf(stderr, "ERROR: Failed to decompress DDS file. \n");
-                failed = 1;
+                return outputPNG;
             }
         }
 
-        // Save as PNG
-        if (!failed)
-        {
-            if (!detexSavePNGFile(&pngTexture, fullPath.c_str()))
-                fprintf(stderr, "ERROR: Failed to convert DDS file to PNG. \n");
-
-            if (!readFile(fullPath, outputPNG))
-                fprintf(stderr, "ERROR: Failed to read PNG file to memory. \n");
-        }
-
-        // Clean up memory and temp files
-        if (ddsTexture)
-            free(ddsTexture);
-        std::error_code ec;
-        fs::remove(fullPath, ec);
+        // Encode as PNG
+        if (!EncodePNG(pngTexture, outputPNG))
+            fprintf(stderr, "ERROR: Failed to convert DDS file to PNG. \n");
 
 #endif
         return outputPNG;
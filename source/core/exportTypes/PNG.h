@@ -12,6 +12,7 @@
 #include <wincodec.h>
 #include "../../../vendor/DirectXTex/DirectXTex/DirectXTex.h"
 #else
+#include <png.h>
 #include "../../../vendor/detex/detex.h"
 #endif
 
@@ -22,6 +23,12 @@ namespace HAYDEN
     class PNGFile
     {
         public:
-            std::vector<uint8_t> ConvertDDStoPNG(std::vector<uint8_t> inputDDS, bool reconstructZ = false);
+            std::vector<uint8_t> ConvertDDStoPNG(const std::vector<uint8_t>& inputDDS, bool reconstructZ = false);
+
+#ifndef _WIN32
+        private:
+            bool ReadDDSTexture(const std::vector<uint8_t>& inputDDS, detexTexture& texture);
+            bool EncodePNG(const detexTexture& texture, std::vector<uint8_t>& outputPNG);
+#endif
     };
 }
\ No newline at end of file
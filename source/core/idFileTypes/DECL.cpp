@@ -2,8 +2,8 @@
 
 namespace HAYDEN
 {
-    // Parse a single line of a .decl file that has been read into std::ifstream
-    void DeclSingleLine::ReadFromStream(std::ifstream& input, std::string line)
+    // Parse a single line of a .decl file, without the trailing '\n'
+    void DeclSingleLine::ReadFromLine(std::string line)
     {
         size_t splitPos = 0;
 
@@ -47,4 +47,24 @@ namespace HAYDEN
             _LineStart = line;
         }
     }
+
+    // Parse a whole .decl file from memory. Lines are split the same way std::getline does.
+    void DeclFile::ReadFromMemory(const std::vector<uint8_t>& declData)
+    {
+        auto lineStart = declData.begin();
+        while (lineStart != declData.end())
+        {
+            auto lineEnd = std::find(lineStart, declData.end(), '\n');
+
+            DeclSingleLine declSingleLine;
+            declSingleLine.ReadFromLine(std::string(lineStart, lineEnd));
+            SetLineData(declSingleLine);
+            LineCount++;
+
+            if (lineEnd == declData.end())
+                break;
+
+            lineStart = lineEnd + 1;
+        }
+    }
 }
\ No newline at end of file
@@ -16,7 +16,7 @@ namespace HAYDEN
         public:
             std::string GetLineVariable() const { return _LineVariable; };
             std::string GetLineValue() const { return _LineValue; };
-            void ReadFromStream(std::ifstream& input, std::string line);
+            void ReadFromLine(std::string line);
 
         private:
             int _FormatIsGood = 1;
@@ -35,6 +35,7 @@ namespace HAYDEN
             DeclSingleLine GetLineData(int lineNumber) const { return _LineData[lineNumber]; }
             void SetFileName(std::string fileName) { _DeclFileName = fileName; }
             void SetLineData(DeclSingleLine lineData) { _LineData.push_back(lineData); }
+            void ReadFromMemory(const std::vector<uint8_t>& declData);
 
         private:
             std::vector<DeclSingleLine> _LineData;
@@ -151,10 +151,11 @@ namespace HAYDEN
         return;
     }
 
-    void LWO::Serialize(LWO_HEADER lwoHeader, std::vector<uint8_t> lwoGeo)
+    void LWO::Serialize(const LWO_HEADER& lwoHeader, const std::vector<uint8_t>& lwoGeo)
     {
         Header = lwoHeader;
-        MeshGeometry.resize(Header.Metadata.NumMeshes);
+        Geometry = ModelGeometry();
+        size_t numMeshes = std::min<size_t>(Header.Metadata.NumMeshes, Header.MeshInfo.size());
 
         uint64_t offset = 0;
         uint64_t offsetNormals = 0;
@@ -176,58 +177,42 @@ namespace HAYDEN
         }
 
         // Allocate
-        for (int i = 0; i < MeshGeometry.size(); i++)
-        {
-            MeshGeometry[i].Vertices.resize(Header.MeshInfo[i].LODInfo[0].NumVertices);
-            MeshGeometry[i].Normals.resize(Header.MeshInfo[i].LODInfo[0].NumVertices);
-            MeshGeometry[i].UVs.resize(Header.MeshInfo[i].LODInfo[0].NumVertices);
-            MeshGeometry[i].Faces.resize(Header.MeshInfo[i].LODInfo[0].NumEdges / 3);
-        }
+        for (int i = 0; i < numMeshes; i++)
+            Geometry.AddSubMesh(Header.MeshInfo[i].MaterialDeclName, Header.MeshInfo[i].LODInfo[0].NumVertices, Header.MeshInfo[i].LODInfo[0].NumEdges / 3);
 
         // Read Vertices
-        for (int i = 0; i < MeshGeometry.size(); i++)
+        for (int i = 0; i < numMeshes; i++)
         {
-            for (int j = 0; j < MeshGeometry[i].Vertices.size(); j++)
-            {
-                PackedVertex packedVertex = *(PackedVertex*)(lwoGeo.data() + offset);
-                MeshGeometry[i].Vertices[j] = MeshGeometry[i].UnpackVertex(packedVertex, Header.MeshInfo[i].LODInfo[0].GeoMeta.VertexOffsetX, Header.MeshInfo[i].LODInfo[0].GeoMeta.VertexOffsetY, Header.MeshInfo[i].LODInfo[0].GeoMeta.VertexOffsetZ, Header.MeshInfo[i].LODInfo[0].GeoMeta.VertexScale);
-                offset += sizeof(PackedVertex);
-            }
+            const SubMesh& subMesh = Geometry.SubMeshes[i];
+            Geometry.UnpackVertices((PackedVertex*)(lwoGeo.data() + offset), subMesh.FirstVertex, subMesh.NumVertices, Header.MeshInfo[i].LODInfo[0].GeoMeta.VertexOffsetX, Header.MeshInfo[i].LODInfo[0].GeoMeta.VertexOffsetY, Header.MeshInfo[i].LODInfo[0].GeoMeta.VertexOffsetZ, Header.MeshInfo[i].LODInfo[0].GeoMeta.VertexScale);
+            offset += subMesh.NumVertices * sizeof(PackedVertex);
         }
-     
+
         // Read Normals
         offset = offsetNormals;
-        for (int i = 0; i < MeshGeometry.size(); i++)
+        for (int i = 0; i < numMeshes; i++)
         {
-            for (int j = 0; j < MeshGeometry[i].Normals.size(); j++)
-            {
-                PackedNormal packedNormal = *(PackedNormal*)(lwoGeo.data() + offset);
-                MeshGeometry[i].Normals[j] = MeshGeometry[i].UnpackNormal(packedNormal);
-                offset += sizeof(PackedNormal);
-            }
+            const SubMesh& subMesh = Geometry.SubMeshes[i];
+            Geometry.UnpackNormals((PackedNormal*)(lwoGeo.data() + offset), subMesh.FirstVertex, subMesh.NumVertices);
+            offset += subMesh.NumVertices * sizeof(PackedNormal);
         }
 
         // Read UVs
         offset = offsetUVs;
-        for (int i = 0; i < MeshGeometry.size(); i++)
+        for (int i = 0; i < numMeshes; i++)
         {
-            for (int j = 0; j < MeshGeometry[i].UVs.size(); j++)
-            {
-                PackedUV packedUV = *(PackedUV*)(lwoGeo.data() + offset);
-                MeshGeometry[i].UVs[j] = MeshGeometry[i].UnpackUV(packedUV, Header.MeshInfo[i].LODInfo[0].GeoMeta.UVMapOffsetU, Header.MeshInfo[i].LODInfo[0].GeoMeta.UVMapOffsetV, Header.MeshInfo[i].LODInfo[0].GeoMeta.UVScale);
-                offset += sizeof(PackedUV);
-            }
+            const SubMesh& subMesh = Geometry.SubMeshes[i];
+            Geometry.UnpackUVs((PackedUV*)(lwoGeo.data() + offset), subMesh.FirstVertex, subMesh.NumVertices, Header.MeshInfo[i].LODInfo[0].GeoMeta.UVMapOffsetU, Header.MeshInfo[i].LODInfo[0].GeoMeta.UVMapOffsetV, Header.MeshInfo[i].LODInfo[0].GeoMeta.UVScale);
+            offset += subMesh.NumVertices * sizeof(PackedUV);
         }
 
         // Read Faces
         offset = offsetFaces;
-        for (int i = 0; i < MeshGeometry.size(); i++)
+        for (int i = 0; i < numMeshes; i++)
         {
-            for (int j = 0; j < MeshGeometry[i].Faces.size(); j++)
-            {
-                MeshGeometry[i].Faces[j] = *(Face*)(lwoGeo.data() + offset);
-                offset += sizeof(Face);
-            }
+            const SubMesh& subMesh = Geometry.SubMeshes[i];
+            Geometry.UnpackFaces((Face*)(lwoGeo.data() + offset), subMesh.FirstIndex, subMesh.NumIndices / 3);
+            offset += (subMesh.NumIndices / 3) * sizeof(Face);
         }
         return;
     }
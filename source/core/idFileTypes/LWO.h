@@ -141,8 +141,8 @@ namespace HAYDEN
     {
 	public:
             LWO_HEADER Header;
-            std::vector<Mesh> MeshGeometry;
-	    void Serialize(LWO_HEADER lwoHeader, std::vector<uint8_t> lwoGeo);
+            ModelGeometry Geometry;
+	    void Serialize(const LWO_HEADER& lwoHeader, const std::vector<uint8_t>& lwoGeo);
     };
 }
 
@@ -137,10 +137,11 @@ namespace HAYDEN
         return;
     }
 
-    void MD6::Serialize(MD6_HEADER md6Header, std::vector<uint8_t> md6Geo)
+    void MD6::Serialize(const MD6_HEADER& md6Header, const std::vector<uint8_t>& md6Geo)
     {
         Header = md6Header;
-        MeshGeometry.resize(Header.NumMeshes);
+        Geometry = ModelGeometry();
+        size_t numMeshes = std::min<size_t>(Header.NumMeshes, Header.MeshInfo.size());
 
         uint64_t offset = 0;
         uint64_t offsetNormals = 0;
@@ -153,58 +154,42 @@ namespace HAYDEN
         offsetFaces = Header.StreamDBData[0].FacesStartOffset;
 
         // Allocate
-        for (int i = 0; i < MeshGeometry.size(); i++)
-        {
-            MeshGeometry[i].Vertices.resize(Header.MeshInfo[i].LODInfo[0].NumVertices);
-            MeshGeometry[i].Normals.resize(Header.MeshInfo[i].LODInfo[0].NumVertices);
-            MeshGeometry[i].UVs.resize(Header.MeshInfo[i].LODInfo[0].NumVertices);
-            MeshGeometry[i].Faces.resize(Header.MeshInfo[i].LODInfo[0].NumFaces);
-        }
+        for (int i = 0; i < numMeshes; i++)
+            Geometry.AddSubMesh(Header.MeshInfo[i].MaterialDeclName, Header.MeshInfo[i].LODInfo[0].NumVertices, Header.MeshInfo[i].LODInfo[0].NumFaces);
 
         // Read Vertices
-        for (int i = 0; i < MeshGeometry.size(); i++)
+        for (int i = 0; i < numMeshes; i++)
         {
-            for (int j = 0; j < MeshGeometry[i].Vertices.size(); j++)
-            {
-                PackedVertex packedVertex = *(PackedVertex*)(md6Geo.data() + offset);
-                MeshGeometry[i].Vertices[j] = MeshGeometry[i].UnpackVertex(packedVertex, Header.MeshInfo[i].LODInfo[0].Meta.VertexOffsetX, Header.MeshInfo[i].LODInfo[0].Meta.VertexOffsetY, Header.MeshInfo[i].LODInfo[0].Meta.VertexOffsetZ, Header.MeshInfo[i].LODInfo[0].Meta.VertexScale);
-                offset += sizeof(PackedVertex);
-            }
+            const SubMesh& subMesh = Geometry.SubMeshes[i];
+            Geometry.UnpackVertices((PackedVertex*)(md6Geo.data() + offset), subMesh.FirstVertex, subMesh.NumVertices, Header.MeshInfo[i].LODInfo[0].Meta.VertexOffsetX, Header.MeshInfo[i].LODInfo[0].Meta.VertexOffsetY, Header.MeshInfo[i].LODInfo[0].Meta.VertexOffsetZ, Header.MeshInfo[i].LODInfo[0].Meta.VertexScale);
+            offset += subMesh.NumVertices * sizeof(PackedVertex);
         }
 
         // Read Normals
         offset = offsetNormals;
-        for (int i = 0; i < MeshGeometry.size(); i++)
+        for (int i = 0; i < numMeshes; i++)
         {
-            for (int j = 0; j < MeshGeometry[i].Normals.size(); j++)
-            {
-                PackedNormal packedNormal = *(PackedNormal*)(md6Geo.data() + offset);
-                MeshGeometry[i].Normals[j] = MeshGeometry[i].UnpackNormal(packedNormal);
-                offset += sizeof(PackedNormal);
-            }
+            const SubMesh& subMesh = Geometry.SubMeshes[i];
+            Geometry.UnpackNormals((PackedNormal*)(md6Geo.data() + offset), subMesh.FirstVertex, subMesh.NumVertices);
+            offset += subMesh.NumVertices * sizeof(PackedNormal);
         }
 
         // Read UVs
         offset = offsetUVs;
-        for (int i = 0; i < MeshGeometry.size(); i++)
+        for (int i = 0; i < numMeshes; i++)
         {
-            for (int j = 0; j < MeshGeometry[i].UVs.size(); j++)
-            {
-                PackedUV packedUV = *(PackedUV*)(md6Geo.data() + offset);
-                MeshGeometry[i].UVs[j] = MeshGeometry[i].UnpackUV(packedUV, Header.MeshInfo[i].LODInfo[0].Meta.UVMapOffsetU, Header.MeshInfo[i].LODInfo[0].Meta.UVMapOffsetV, Header.MeshInfo[i].LODInfo[0].Meta.UVScale);
-                offset += sizeof(PackedUV);
-            }
+            const SubMesh& subMesh = Geometry.SubMeshes[i];
+            Geometry.UnpackUVs((PackedUV*)(md6Geo.data() + offset), subMesh.FirstVertex, subMesh.NumVertices, Header.MeshInfo[i].LODInfo[0].Meta.UVMapOffsetU, Header.MeshInfo[i].LODInfo[0].Meta.UVMapOffsetV, Header.MeshInfo[i].LODInfo[0].Meta.UVScale);
+            offset += subMesh.NumVertices * sizeof(PackedUV);
         }
 
         // Read Faces
         offset = offsetFaces;
-        for (int i = 0; i < MeshGeometry.size(); i++)
+        for (int i = 0; i < numMeshes; i++)
         {
-            for (int j = 0; j < MeshGeometry[i].Faces.size(); j++)
-            {
-                MeshGeometry[i].Faces[j] = *(Face*)(md6Geo.data() + offset);
-                offset += sizeof(Face);
-            }
+            const SubMesh& subMesh = Geometry.SubMeshes[i];
+            Geometry.UnpackFaces((Face*)(md6Geo.data() + offset), subMesh.FirstIndex, subMesh.NumIndices / 3);
+            offset += (subMesh.NumIndices / 3) * sizeof(Face);
         }
         return;
     }
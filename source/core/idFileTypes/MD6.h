@@ -169,8 +169,8 @@ namespace HAYDEN
     {
         public:
             MD6_HEADER Header;
-            std::vector<Mesh> MeshGeometry;
-            void Serialize(MD6_HEADER md6Header, std::vector<uint8_t> md6Geo);
+            ModelGeometry Geometry;
+            void Serialize(const MD6_HEADER& md6Header, const std::vector<uint8_t>& md6Geo);
     };
 }
 
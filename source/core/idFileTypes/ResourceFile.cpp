@@ -2,58 +2,83 @@
 
 namespace HAYDEN
 {
-    // Reads binary .resources file from local filesystem
+    // Returns a view of a null-terminated string in the strings section, or an empty view if out of range
+    std::string_view ResourceFile::GetResourceStringEntry(const uint64_t i) const
+    {
+        if (i >= _NumStrings)
+            return std::string_view();
+
+        uint64_t stringOffset = _StringOffsets[i] - _StringOffsets[0];
+        if (stringOffset >= _StringDataSize)
+            return std::string_view();
+
+        const char* stringStart = _StringData + stringOffset;
+        const char* stringEnd = (const char*)memchr(stringStart, 0, _StringDataSize - stringOffset);
+        if (stringEnd == NULL)
+            stringEnd = _StringData + _StringDataSize;
+
+        return std::string_view(stringStart, stringEnd - stringStart);
+    }
+
+    // Maps binary .resources file from local filesystem and overlays the index tables on it
     ResourceFile::ResourceFile(const fs::path& filePath)
     {
         FilePath = filePath.string();
-        FILE* f = fopen(FilePath.c_str(), "rb");
-        if (f == NULL)
+        if (!_File.Open(filePath))
         {
             fprintf(stderr, "ERROR : ResourceFile : Failed to open %s for reading.\n", FilePath.c_str());
             return;
         }
 
-        if (f != NULL)
+        // .resources file header
+        const ResourceFileHeader* header = (const ResourceFileHeader*)_File.GetRange(0, sizeof(ResourceFileHeader));
+        if (header == NULL)
         {
-            // Read .resources file header
-            fseek(f, 0, SEEK_SET);
-            fread(&_Header, sizeof(ResourceFileHeader), 1, f);
-            _FileEntries.resize(_Header.NumFileEntries);
-
-            // Read .resources file entries
-            for (uint64_t i = 0; i < _FileEntries.size(); i++)
-                fread(&_FileEntries[i], sizeof(ResourceFileEntry), 1, f);
-
-            // Read total # of strings in resource file
-            fread(&_NumStrings, sizeof(uint64_t), 1, f);
-
-            // Allocate vectors
-            _PathStringIndexes.resize(_Header.NumPathStringIndexes);
-            _StringEntries.resize(_NumStrings);
-            _StringOffsets.resize(_NumStrings + 1);
-            _StringOffsets[_NumStrings] = _Header.AddrDependencyEntries; // to find last entry string length
-
-            // Read string offsets into vector
-            for (uint64_t i = 0; i < _NumStrings; i++)
-                fread(&_StringOffsets[i], 8, 1, f);
-
-            // Read strings into vector
-            for (uint64_t i = 0; i < _NumStrings; i++)
-            {
-                int stringLength = _StringOffsets[i + 1] - _StringOffsets[i];
-                char* stringBuffer = new char[stringLength];
-                fread(stringBuffer, stringLength, 1, f);
-                _StringEntries[i] = stringBuffer;
-            }
-
-            // Skip ahead to string indexes
-            uint64_t addrPathStringIndexes = _Header.AddrDependencyIndexes + (_Header.NumDependencyIndexes * sizeof(int));
-            fseek(f, addrPathStringIndexes, SEEK_SET);
-
-            // Read string indexes into vector
-            for (uint64_t i = 0; i < _Header.NumPathStringIndexes; i++)
-                fread(&_PathStringIndexes[i], sizeof(uint64_t), 1, f);
+            fprintf(stderr, "ERROR : ResourceFile : %s is too small to be a .resources file.\n", FilePath.c_str());
+            return;
         }
-        fclose(f);
+
+        // .resources file entries
+        uint64_t offset = sizeof(ResourceFileHeader);
+        const ResourceFileEntry* fileEntries = (const ResourceFileEntry*)_File.GetRange(offset, (uint64_t)header->NumFileEntries * sizeof(ResourceFileEntry));
+        offset += (uint64_t)header->NumFileEntries * sizeof(ResourceFileEntry);
+
+        // Total # of strings in resource file, followed by string offsets
+        const uint64_t* numStrings = (const uint64_t*)_File.GetRange(offset, sizeof(uint64_t));
+        offset += sizeof(uint64_t);
+
+        if (fileEntries == NULL || numStrings == NULL || *numStrings > _File.Size() / sizeof(uint64_t))
+        {
+            fprintf(stderr, "ERROR : ResourceFile : %s has a truncated file index.\n", FilePath.c_str());
+            return;
+        }
+
+        const uint64_t* stringOffsets = (const uint64_t*)_File.GetRange(offset, *numStrings * sizeof(uint64_t));
+        offset += *numStrings * sizeof(uint64_t);
+
+        // Strings follow the offsets and run until the dependency entries
+        uint64_t stringDataEnd = header->AddrDependencyEntries;
+        if (stringDataEnd <= offset || stringDataEnd > _File.Size())
+            stringDataEnd = _File.Size();
+
+        // Path string indexes, located after the dependency indexes
+        uint64_t addrPathStringIndexes = header->AddrDependencyIndexes + ((uint64_t)header->NumDependencyIndexes * sizeof(uint32_t));
+        const uint64_t* pathStringIndexes = (const uint64_t*)_File.GetRange(addrPathStringIndexes, (uint64_t)header->NumPathStringIndexes * sizeof(uint64_t));
+
+        if (stringOffsets == NULL || pathStringIndexes == NULL)
+        {
+            fprintf(stderr, "ERROR : ResourceFile : %s has a truncated string table.\n", FilePath.c_str());
+            return;
+        }
+
+        _Header = header;
+        _FileEntries = fileEntries;
+        _NumFileEntries = header->NumFileEntries;
+        _NumStrings = *numStrings;
+        _StringOffsets = stringOffsets;
+        _StringData = (const char*)_File.Data() + offset;
+        _StringDataSize = stringDataEnd - offset;
+        _PathStringIndexes = pathStringIndexes;
+        _NumPathStringIndexes = header->NumPathStringIndexes;
     }
-}
\ No newline at end of file
+}
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <cstring>
 #include <vector>
 #include <filesystem>
 
-#include "ResourceFile.h"
+#include "../MemoryMappedFile.h"
 
 #pragma pack(push)  // Not portable, sorry.
 #pragma pack(1)     // Works on my machine (TM).
@@ -117,28 +119,39 @@ namespace HAYDEN
             // External, passed into constructor
             std::string FilePath;
 
-            // Getters
-            uint32_t GetNumFileEntries() const { return _Header.NumFileEntries; }
-            ResourceFileEntry& GetResourceFileEntry(int i) { return _FileEntries[i]; }
-            std::string GetResourceStringEntry(int i) const { return _StringEntries[i]; }
-            std::vector<uint64_t> GetAllPathStringIndexes() const { return _PathStringIndexes; }
-
-            // Reads a binary .resources file from local filesystem
+            // Getters. Entries and strings point directly into the mapped file, nothing is copied.
+            bool IsLoaded() const { return _Header != NULL; }
+            uint32_t GetNumFileEntries() const { return _NumFileEntries; }
+            uint32_t GetNumPathStringIndexes() const { return _NumPathStringIndexes; }
+            uint64_t GetNumStrings() const { return _NumStrings; }
+            const ResourceFileHeader& GetHeader() const { return *_Header; }
+            const ResourceFileEntry& GetResourceFileEntry(const uint32_t i) const { return _FileEntries[i]; }
+            uint64_t GetPathStringIndex(const uint32_t i) const { return _PathStringIndexes[i]; }
+            std::string_view GetResourceStringEntry(const uint64_t i) const;
+
+            // Maps a binary .resources file from local filesystem
             ResourceFile(const fs::path& filePath);
 
         private:
 
+            // Memory mapping of the .resources file, everything below points into it
+            MemoryMappedFile _File;
+
             // Binary data within the .resources file
-            ResourceFileHeader _Header;                             // first 0x7C bytes in file
-            std::vector<ResourceFileEntry> _FileEntries;            // immediately after ResourceFileHeader,  repeating 0x90 byte sequence
+            const ResourceFileHeader* _Header = NULL;               // first 0x7C bytes in file
+            const ResourceFileEntry* _FileEntries = NULL;           // immediately after ResourceFileHeader,  repeating 0x90 byte sequence
+            uint32_t _NumFileEntries = 0;
 
             uint64_t _NumStrings = 0;                               // immediately after last ResourceFileEntry
-            std::vector<uint64_t> _StringOffsets;                   // immediately after _numStrings
-            std::vector<std::string> _StringEntries;                // immediately atter _stringOffsets
+            const uint64_t* _StringOffsets = NULL;                  // immediately after _numStrings
+            const char* _StringData = NULL;                         // immediately atter _stringOffsets
+            uint64_t _StringDataSize = 0;
+
+            // (not implemented)  ResourceFileDependency entries,  immediately after _StringData,  repeating 0x20 byte sequence
+            // (not implemented)  uint32_t dependency indexes,  immediately after the dependency entries
 
-            std::vector<ResourceFileDependency> _FileDependencies;  // (not implemented)  immediately after _stringEntries,  repeating 0x20 byte sequence
-            std::vector<uint32_t> _DependencyIndexes;               // (not implemented)  immediately after _DependencyEntries,  index into _DependencyEntries
-            std::vector<uint64_t> _PathStringIndexes;               // immediately after _dependencyIndexes,  index into _stringEntries
+            const uint64_t* _PathStringIndexes = NULL;              // immediately after dependency indexes,  index into string entries
+            uint32_t _NumPathStringIndexes = 0;
     };
 }
 
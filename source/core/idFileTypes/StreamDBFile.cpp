@@ -2,28 +2,6 @@
 
 namespace HAYDEN
 {
-    // Attempts to locate a StreamDBEntry based on a known streamedFileID + streamedDataLength.
-    StreamDBEntry StreamDBFile::LocateStreamDBEntry(const uint64_t streamedFileID, const uint64_t streamedDataLength) const
-    {
-        for (uint64_t i = 0; i < _StreamDBHeader.NumEntries; i++)
-        {
-            // Match
-            if ((streamedFileID == _StreamDBEntries[i].FileID) && (streamedDataLength == _StreamDBEntries[i].CompressedSize))
-                return _StreamDBEntries[i];
-
-            // FileID matches, but compressed size doesn't. 
-            if ((streamedFileID == _StreamDBEntries[i].FileID) && (streamedDataLength < _StreamDBEntries[i].CompressedSize))
-            {
-                // Sometimes it will match the next entry in sequence, so check this.
-                if (streamedDataLength == _StreamDBEntries[i + 1].CompressedSize)
-                    return _StreamDBEntries[i + 1];
-            }
-        }
-
-        // No match found, return empty StreamDBEntry
-        return StreamDBEntry();
-    }
-
     // Extracts an embedded file in StreamDB, returning it as a byte vector
     std::vector<uint8_t> StreamDBFile::GetEmbeddedFile(const std::string streamDBFileName, const StreamDBEntry streamDBEntry) const
     {
@@ -31,16 +9,12 @@ namespace HAYDEN
         uint64_t fileOffset = streamDBEntry.Offset16;
         fileOffset = fileOffset * 16;
 
-        // Read from stream
-        std::ifstream f;
+        // Read through the shared handle pool, the .streamdb stays open between calls
         std::vector<uint8_t> fileData(streamDBEntry.CompressedSize);
-        f.open(streamDBFileName, std::ios::in | std::ios::binary);
-        f.seekg(fileOffset, std::ios_base::beg);
-        f.read(reinterpret_cast<char*>(fileData.data()), streamDBEntry.CompressedSize);
+        int64_t bytesRead = FileHandlePool::GetSharedPool().ReadAt(streamDBFileName, fileOffset, fileData.data(), streamDBEntry.CompressedSize);
 
         // Validate number of bytes read, 0 if failed
-        fileData.resize(f.gcount());
-        f.close();
+        fileData.resize(bytesRead > 0 ? bytesRead : 0);
 
         return fileData;
     }
@@ -65,8 +39,7 @@ namespace HAYDEN
             _StreamDBEntries.resize(_StreamDBHeader.NumEntries);
 
             // Read .streamdb file entries
-            for (int i = 0; i < _StreamDBHeader.NumEntries; i++)
-                fread(&_StreamDBEntries[i], sizeof(StreamDBEntry), 1, f);
+            _StreamDBEntries.resize(fread(_StreamDBEntries.data(), sizeof(StreamDBEntry), _StreamDBEntries.size(), f));
 
             fclose(f);
         }
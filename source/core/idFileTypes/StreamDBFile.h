@@ -4,6 +4,8 @@
 #include <vector>
 #include <filesystem>
 
+#include "../FileHandlePool.h"
+
 #pragma pack(push)  // Not portable, sorry.
 #pragma pack(1)     // Works on my machine (TM).
 
@@ -34,7 +36,7 @@ namespace HAYDEN
         public:
 
             std::string FilePath;
-            StreamDBEntry LocateStreamDBEntry(const uint64_t streamedFileID, const uint64_t streamedDataLength) const;
+            const std::vector<StreamDBEntry>& GetEntries() const { return _StreamDBEntries; }
             std::vector<uint8_t> GetEmbeddedFile(const std::string streamDBFileName, const StreamDBEntry streamDBEntry) const;
             StreamDBFile(const fs::path& path);
 
@@ -1,8 +1,17 @@
 #include "StreamDBGeometry.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SAMUEL_GEOMETRY_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 namespace HAYDEN
 {
-    Vertex Mesh::UnpackVertex(PackedVertex packedVertex, float_t offsetX, float_t offsetY, float_t offsetZ, float_t vertexScale)
+    Vertex Mesh::UnpackVertex(const PackedVertex& packedVertex, float_t offsetX, float_t offsetY, float_t offsetZ, float_t vertexScale)
     {
         Vertex vertex;
         float packedX = packedVertex.X;
@@ -15,7 +24,7 @@ namespace HAYDEN
         return vertex;
     }
 
-    Normal Mesh::UnpackNormal(PackedNormal packedNormal)
+    Normal Mesh::UnpackNormal(const PackedNormal& packedNormal)
     {
         Normal normal;
         float packedXn = packedNormal.Xn;
@@ -28,14 +37,278 @@ namespace HAYDEN
         return normal;
     }
 
-    UV Mesh::UnpackUV(PackedUV packed, float_t offsetU, float_t offsetV, float_t uvScale)
+    UV Mesh::UnpackUV(const PackedUV& packed, float_t offsetU, float_t offsetV, float_t uvScale)
     {
         UV uv;
         float packedU = packed.U;
         float packedV = packed.V;
 
+        // std::abs, plain abs() resolves to the int overload on some compilers and truncates V
         uv.U = ((packedU / 65535) * uvScale) + offsetU;
-        uv.V = abs(((abs(packedV / 65535)) * uvScale) - (1 - offsetV));
+        uv.V = std::abs(((std::abs(packedV / 65535)) * uvScale) - (1 - offsetV));
         return uv;
     }
-}
\ No newline at end of file
+
+    // Append a submesh and allocate its vertices and indices. Returns the submesh index.
+    size_t ModelGeometry::AddSubMesh(const std::string& materialDeclName, const uint32_t numVertices, const uint32_t numFaces)
+    {
+        SubMesh subMesh;
+        subMesh.MaterialDeclName = materialDeclName;
+        subMesh.FirstVertex = (uint32_t)X.size();
+        subMesh.NumVertices = numVertices;
+        subMesh.FirstIndex = (uint32_t)Indices.size();
+        subMesh.NumIndices = numFaces * 3;
+        SubMeshes.push_back(subMesh);
+
+        size_t vertexCount = (size_t)subMesh.FirstVertex + numVertices;
+        for (std::vector<float_t>* component : { &X, &Y, &Z, &NormalX, &NormalY, &NormalZ, &U, &V })
+            component->resize(vertexCount);
+
+        Indices.resize((size_t)subMesh.FirstIndex + subMesh.NumIndices);
+        return SubMeshes.size() - 1;
+    }
+
+    // SIMD kernels below do the same operations in the same order as the Mesh::Unpack* functions (no FMA),
+    // so results are bit-identical. Packed elements are deinterleaved with 32-bit lane masks and shifts:
+    // a PackedVertex is two dwords (X | Y << 16, Z | pad << 16), a PackedNormal's first dword is Xn | Yn << 8 | Zn << 16
+    // and a PackedUV is one dword (U | V << 16).
+
+    void ModelGeometry::UnpackVertices(const PackedVertex* packedVertices, const size_t firstVertex, const size_t count, float_t offsetX, float_t offsetY, float_t offsetZ, float_t vertexScale)
+    {
+        float_t* outX = X.data() + firstVertex;
+        float_t* outY = Y.data() + firstVertex;
+        float_t* outZ = Z.data() + firstVertex;
+        size_t i = 0;
+
+#ifdef __AVX2__
+        const __m256i lowMask = _mm256_set1_epi32(0xFFFF);
+        const __m256 divisor = _mm256_set1_ps(65535);
+        const __m256 scale = _mm256_set1_ps(vertexScale);
+        const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 packed0 = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(packedVertices + i)));
+            __m256 packed1 = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(packedVertices + i + 4)));
+
+            // Even dwords hold X | Y << 16, odd dwords Z | pad << 16. Shuffles work per 128-bit lane, so fix up the order after.
+            __m256i xy = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(packed0, packed1, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0));
+            __m256i zw = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(packed0, packed1, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0));
+
+            __m256 packedX = _mm256_cvtepi32_ps(_mm256_and_si256(xy, lowMask));
+            __m256 packedY = _mm256_cvtepi32_ps(_mm256_srli_epi32(xy, 16));
+            __m256 packedZ = _mm256_cvtepi32_ps(_mm256_and_si256(zw, lowMask));
+
+            _mm256_storeu_ps(outX + i, _mm256_add_ps(_mm256_mul_ps(_mm256_div_ps(packedX, divisor), scale), _mm256_set1_ps(offsetX)));
+            _mm256_storeu_ps(outZ + i, _mm256_xor_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_div_ps(packedY, divisor), scale), _mm256_set1_ps(offsetY)), signBit));
+            _mm256_storeu_ps(outY + i, _mm256_add_ps(_mm256_mul_ps(_mm256_div_ps(packedZ, divisor), scale), _mm256_set1_ps(offsetZ)));
+        }
+#elif defined(SAMUEL_GEOMETRY_SSE2)
+        const __m128i lowMask = _mm_set1_epi32(0xFFFF);
+        const __m128 divisor = _mm_set1_ps(65535);
+        const __m128 scale = _mm_set1_ps(vertexScale);
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 packed0 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(packedVertices + i)));
+            __m128 packed1 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(packedVertices + i + 2)));
+            __m128i xy = _mm_castps_si128(_mm_shuffle_ps(packed0, packed1, _MM_SHUFFLE(2, 0, 2, 0)));
+            __m128i zw = _mm_castps_si128(_mm_shuffle_ps(packed0, packed1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+            __m128 packedX = _mm_cvtepi32_ps(_mm_and_si128(xy, lowMask));
+            __m128 packedY = _mm_cvtepi32_ps(_mm_srli_epi32(xy, 16));
+            __m128 packedZ = _mm_cvtepi32_ps(_mm_and_si128(zw, lowMask));
+
+            _mm_storeu_ps(outX + i, _mm_add_ps(_mm_mul_ps(_mm_div_ps(packedX, divisor), scale), _mm_set1_ps(offsetX)));
+            _mm_storeu_ps(outZ + i, _mm_xor_ps(_mm_add_ps(_mm_mul_ps(_mm_div_ps(packedY, divisor), scale), _mm_set1_ps(offsetY)), signBit));
+            _mm_storeu_ps(outY + i, _mm_add_ps(_mm_mul_ps(_mm_div_ps(packedZ, divisor), scale), _mm_set1_ps(offsetZ)));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            Vertex vertex = Mesh::UnpackVertex(packedVertices[i], offsetX, offsetY, offsetZ, vertexScale);
+            outX[i] = vertex.X;
+            outY[i] = vertex.Y;
+            outZ[i] = vertex.Z;
+        }
+    }
+
+    void ModelGeometry::UnpackNormals(const PackedNormal* packedNormals, const size_t firstVertex, const size_t count)
+    {
+        float_t* outX = NormalX.data() + firstVertex;
+        float_t* outY = NormalY.data() + firstVertex;
+        float_t* outZ = NormalZ.data() + firstVertex;
+        size_t i = 0;
+
+#ifdef __AVX2__
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        const __m256 divisor = _mm256_set1_ps(255);
+        const __m256 two = _mm256_set1_ps(2);
+        const __m256 one = _mm256_set1_ps(1);
+        const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            // Even dwords hold the normal, odd dwords the tangent (skipped)
+            __m256 packed0 = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(packedNormals + i)));
+            __m256 packed1 = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(packedNormals + i + 4)));
+            __m256i normal = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(packed0, packed1, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0));
+
+            __m256 packedX = _mm256_cvtepi32_ps(_mm256_and_si256(normal, byteMask));
+            __m256 packedY = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(normal, 8), byteMask));
+            __m256 packedZ = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(normal, 16), byteMask));
+
+            _mm256_storeu_ps(outX + i, _mm256_sub_ps(_mm256_mul_ps(_mm256_div_ps(packedX, divisor), two), one));
+            _mm256_storeu_ps(outY + i, _mm256_xor_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_div_ps(packedY, divisor), two), one), signBit));
+            _mm256_storeu_ps(outZ + i, _mm256_sub_ps(_mm256_mul_ps(_mm256_div_ps(packedZ, divisor), two), one));
+        }
+#elif defined(SAMUEL_GEOMETRY_SSE2)
+        const __m128i byteMask = _mm_set1_epi32(0xFF);
+        const __m128 divisor = _mm_set1_ps(255);
+        const __m128 two = _mm_set1_ps(2);
+        const __m128 one = _mm_set1_ps(1);
+        const __m128 signBit = _mm_set1_ps(-0.0f);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 packed0 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(packedNormals + i)));
+            __m128 packed1 = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(packedNormals + i + 2)));
+            __m128i normal = _mm_castps_si128(_mm_shuffle_ps(packed0, packed1, _MM_SHUFFLE(2, 0, 2, 0)));
+
+            __m128 packedX = _mm_cvtepi32_ps(_mm_and_si128(normal, byteMask));
+            __m128 packedY = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(normal, 8), byteMask));
+            __m128 packedZ = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(normal, 16), byteMask));
+
+            _mm_storeu_ps(outX + i, _mm_sub_ps(_mm_mul_ps(_mm_div_ps(packedX, divisor), two), one));
+            _mm_storeu_ps(outY + i, _mm_xor_ps(_mm_sub_ps(_mm_mul_ps(_mm_div_ps(packedY, divisor), two), one), signBit));
+            _mm_storeu_ps(outZ + i, _mm_sub_ps(_mm_mul_ps(_mm_div_ps(packedZ, divisor), two), one));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            Normal normal = Mesh::UnpackNormal(packedNormals[i]);
+            outX[i] = normal.Xn;
+            outY[i] = normal.Yn;
+            outZ[i] = normal.Zn;
+        }
+    }
+
+    void ModelGeometry::UnpackUVs(const PackedUV* packedUVs, const size_t firstVertex, const size_t count, float_t offsetU, float_t offsetV, float_t uvScale)
+    {
+        float_t* outU = U.data() + firstVertex;
+        float_t* outV = V.data() + firstVertex;
+        size_t i = 0;
+
+        // V = |V * scale - (1 - offsetV)|, the inner abs is a no-op for unsigned input
+#ifdef __AVX2__
+        const __m256i lowMask = _mm256_set1_epi32(0xFFFF);
+        const __m256 divisor = _mm256_set1_ps(65535);
+        const __m256 scale = _mm256_set1_ps(uvScale);
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i packed = _mm256_loadu_si256((const __m256i*)(packedUVs + i));
+            __m256 packedU = _mm256_cvtepi32_ps(_mm256_and_si256(packed, lowMask));
+            __m256 packedV = _mm256_cvtepi32_ps(_mm256_srli_epi32(packed, 16));
+
+            _mm256_storeu_ps(outU + i, _mm256_add_ps(_mm256_mul_ps(_mm256_div_ps(packedU, divisor), scale), _mm256_set1_ps(offsetU)));
+            _mm256_storeu_ps(outV + i, _mm256_and_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_div_ps(packedV, divisor), scale), _mm256_set1_ps(1 - offsetV)), absMask));
+        }
+#elif defined(SAMUEL_GEOMETRY_SSE2)
+        const __m128i lowMask = _mm_set1_epi32(0xFFFF);
+        const __m128 divisor = _mm_set1_ps(65535);
+        const __m128 scale = _mm_set1_ps(uvScale);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i packed = _mm_loadu_si128((const __m128i*)(packedUVs + i));
+            __m128 packedU = _mm_cvtepi32_ps(_mm_and_si128(packed, lowMask));
+            __m128 packedV = _mm_cvtepi32_ps(_mm_srli_epi32(packed, 16));
+
+            _mm_storeu_ps(outU + i, _mm_add_ps(_mm_mul_ps(_mm_div_ps(packedU, divisor), scale), _mm_set1_ps(offsetU)));
+            _mm_storeu_ps(outV + i, _mm_and_ps(_mm_sub_ps(_mm_mul_ps(_mm_div_ps(packedV, divisor), scale), _mm_set1_ps(1 - offsetV)), absMask));
+        }
+#endif
+
+        for (; i < count; i++)
+        {
+            UV uv = Mesh::UnpackUV(packedUVs[i], offsetU, offsetV, uvScale);
+            outU[i] = uv.U;
+            outV[i] = uv.V;
+        }
+    }
+
+    // Widens the uint16 face indices into the index buffer
+    void ModelGeometry::UnpackFaces(const Face* faces, const size_t firstIndex, const size_t numFaces)
+    {
+        const uint16_t* packed = (const uint16_t*)faces;
+        uint32_t* out = Indices.data() + firstIndex;
+        size_t count = numFaces * 3;
+        size_t i = 0;
+
+#ifdef SAMUEL_GEOMETRY_SSE2
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i indices = _mm_loadu_si128((const __m128i*)(packed + i));
+            _mm_storeu_si128((__m128i*)(out + i), _mm_unpacklo_epi16(indices, zero));
+            _mm_storeu_si128((__m128i*)(out + i + 4), _mm_unpackhi_epi16(indices, zero));
+        }
+#endif
+
+        for (; i < count; i++)
+            out[i] = packed[i];
+    }
+
+    // Axis-aligned bounds of [firstVertex, firstVertex + count). Returns 0 if the range is empty.
+    bool ModelGeometry::GetBounds(const size_t firstVertex, const size_t count, float_t min[3], float_t max[3]) const
+    {
+        if (count == 0 || firstVertex + count > X.size())
+            return 0;
+
+        const float_t* components[3] = { X.data() + firstVertex, Y.data() + firstVertex, Z.data() + firstVertex };
+        for (int c = 0; c < 3; c++)
+        {
+            const float_t* values = components[c];
+            float_t componentMin = values[0];
+            float_t componentMax = values[0];
+            size_t i = 0;
+
+#ifdef SAMUEL_GEOMETRY_SSE2
+            if (count >= 4)
+            {
+                __m128 minimum = _mm_loadu_ps(values);
+                __m128 maximum = minimum;
+                for (i = 4; i + 4 <= count; i += 4)
+                {
+                    __m128 value = _mm_loadu_ps(values + i);
+                    minimum = _mm_min_ps(minimum, value);
+                    maximum = _mm_max_ps(maximum, value);
+                }
+
+                float_t lanes[4];
+                _mm_storeu_ps(lanes, minimum);
+                componentMin = std::min({ lanes[0], lanes[1], lanes[2], lanes[3] });
+                _mm_storeu_ps(lanes, maximum);
+                componentMax = std::max({ lanes[0], lanes[1], lanes[2], lanes[3] });
+            }
+#endif
+
+            for (; i < count; i++)
+            {
+                componentMin = std::min(componentMin, values[i]);
+                componentMax = std::max(componentMax, values[i]);
+            }
+
+            min[c] = componentMin;
+            max[c] = componentMax;
+        }
+        return 1;
+    }
+}
@@ -3,6 +3,9 @@
 #include <vector>
 #include <cmath>
 #include <cstdint>
+#include <cstddef>
+#include <string>
+#include <algorithm>
 
 #include "../Common.h"
 
@@ -71,9 +74,52 @@ namespace HAYDEN
             std::vector<Normal> Normals;
             std::vector<UV> UVs;
             std::vector<Face> Faces;
-            Vertex UnpackVertex(PackedVertex packedVertex, float_t offsetX, float_t offsetY, float_t offsetZ, float_t vertexScale);
-            Normal UnpackNormal(PackedNormal packedNormal);
-            UV UnpackUV(PackedUV packedUV, float_t offsetU, float_t offsetV, float_t uvScale);
+            static Vertex UnpackVertex(const PackedVertex& packedVertex, float_t offsetX, float_t offsetY, float_t offsetZ, float_t vertexScale);
+            static Normal UnpackNormal(const PackedNormal& packedNormal);
+            static UV UnpackUV(const PackedUV& packedUV, float_t offsetU, float_t offsetV, float_t uvScale);
+
+    };
+
+    // Range of a ModelGeometry belonging to one mesh (LOD 0)
+    struct SubMesh
+    {
+        std::string MaterialDeclName;
+        uint32_t FirstVertex = 0;
+        uint32_t NumVertices = 0;
+        uint32_t FirstIndex = 0;
+        uint32_t NumIndices = 0;
+    };
+
+    // Structure-of-arrays geometry for a whole model. Each vertex attribute component has its own array,
+    // faces are a flat index buffer (F1, F2, F3 per face) relative to the submesh's FirstVertex.
+    class ModelGeometry
+    {
+        public:
+            std::vector<float_t> X;
+            std::vector<float_t> Y;
+            std::vector<float_t> Z;
+            std::vector<float_t> NormalX;
+            std::vector<float_t> NormalY;
+            std::vector<float_t> NormalZ;
+            std::vector<float_t> U;
+            std::vector<float_t> V;
+            std::vector<uint32_t> Indices;
+            std::vector<SubMesh> SubMeshes;
+
+            size_t GetVertexCount() const { return X.size(); }
+
+            // Append a submesh and allocate its vertices and indices. Returns the submesh index.
+            size_t AddSubMesh(const std::string& materialDeclName, const uint32_t numVertices, const uint32_t numFaces);
+
+            // Dequantize streams into [firstVertex, firstVertex + count), using SSE2/AVX2 when available.
+            // Results match Mesh::UnpackVertex/UnpackNormal/UnpackUV exactly.
+            void UnpackVertices(const PackedVertex* packedVertices, const size_t firstVertex, const size_t count, float_t offsetX, float_t offsetY, float_t offsetZ, float_t vertexScale);
+            void UnpackNormals(const PackedNormal* packedNormals, const size_t firstVertex, const size_t count);
+            void UnpackUVs(const PackedUV* packedUVs, const size_t firstVertex, const size_t count, float_t offsetU, float_t offsetV, float_t uvScale);
+            void UnpackFaces(const Face* faces, const size_t firstIndex, const size_t numFaces);
+
+            // Axis-aligned bounds of [firstVertex, firstVertex + count). Returns 0 if the range is empty.
+            bool GetBounds(const size_t firstVertex, const size_t count, float_t min[3], float_t max[3]) const;
     };
 
     class StreamedGeometry
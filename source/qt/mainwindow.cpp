@@ -5,6 +5,14 @@
 MainWindow::MainWindow(QWidget *parent): QMainWindow(parent), ui(new Ui::MainWindow)
 {
     ui->setupUi(this);
+
+    // Table rows come from SAM's entries through a filtering/sorting proxy
+    _ResourceModel = new ResourceTableModel(this);
+    _ResourceProxyModel = new ResourceFilterProxyModel(this);
+    _ResourceProxyModel->setSourceModel(_ResourceModel);
+    ui->tableView->setModel(_ResourceProxyModel);
+    ui->tableView->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+
     ui->btnClear->setVisible(false);
     ui->btnSearch->setEnabled(false);
     ui->btnExportSelected->setEnabled(false);
@@ -51,12 +59,11 @@ void MainWindow::ThrowError(std::string errorMessage, std::string errorDetail)
 // Private Functions
 void MainWindow::DisableGUI()
 {
-    ui->inputSearch->clear();
     ui->inputSearch->setEnabled(false);
     ui->btnSearch->setEnabled(false);
     ui->btnExportSelected->setEnabled(false);
     ui->btnLoadResource->setEnabled(false);
-    ui->tableWidget->setEnabled(false);
+    ui->tableView->setEnabled(false);
     ui->radioShowAll->setEnabled(false);
     ui->radioShowDecl->setEnabled(false);
     ui->radioShowEntities->setEnabled(false);
@@ -70,7 +77,7 @@ void MainWindow::EnableGUI()
     ui->btnSearch->setEnabled(true);
     ui->btnExportSelected->setEnabled(true);
     ui->btnLoadResource->setEnabled(true);
-    ui->tableWidget->setEnabled(true);
+    ui->tableView->setEnabled(true);
     ui->radioShowAll->setEnabled(true);
     ui->radioShowDecl->setEnabled(true);
     ui->radioShowEntities->setEnabled(true);
@@ -80,12 +87,10 @@ void MainWindow::EnableGUI()
 }
 void MainWindow::ResetGUITable()
 {
-    _ViewIsFiltered = 0;
     ui->labelStatus->clear();
-    ui->tableWidget->clearContents();
-    ui->tableWidget->setRowCount(0);
-    ui->tableWidget->setEnabled(true);
-    ui->tableWidget->setSortingEnabled(true);
+    ClearSearch();
+    _ResourceModel->Clear();
+    ui->tableView->setEnabled(true);
     return;
 }
 
@@ -111,138 +116,50 @@ std::vector<std::string> MainWindow::SplitSearchTerms(std::string inputString)
     return searchWords;
 }
 
-void MainWindow::PopulateGUIResourceTable(std::vector<std::string> searchWords)
+// Points the table at the loaded .resources entries. Filters and sorting are kept.
+void MainWindow::PopulateGUIResourceTable()
+{
+    _ResourceModel->SetEntries(&SAM.GetResourceData());
+    UpdateResourceCountLabel();
+    return;
+}
+void MainWindow::SetSearchMode(const int searchMode)
+{
+    _ResourceProxyModel->SetSearchMode(searchMode);
+    UpdateResourceCountLabel();
+    return;
+}
+// Filters the table to names containing every search word. Runs as the user types.
+void MainWindow::ApplySearch(const QString &searchText)
 {
-    // Must disable sorting or rows won't populate correctly
-    ui->tableWidget->setSortingEnabled(false);
+    std::vector<std::string> searchWords = SplitSearchTerms(searchText.toStdString());
+    bool hasSearchWords = std::any_of(searchWords.begin(), searchWords.end(), [](const std::string& word) { return !word.empty(); });
 
-    // Clear any existing contents
-    ui->tableWidget->clearContents();
-    ui->tableWidget->setRowCount(0);
-    _ViewIsFiltered = 0;
+    if (hasSearchWords)
+        _ResourceProxyModel->SetSearchMatches(&_SearchIndex.Search(searchWords));
+    else
+        _ResourceProxyModel->SetSearchMatches(NULL);
 
-    // Load resource file data
-    std::vector<HAYDEN::ResourceEntry> resourceData = SAM.GetResourceData();
-    for (int i = 0; i < resourceData.size(); i++)
+    ui->btnClear->setVisible(hasSearchWords);
+    UpdateResourceCountLabel();
+    return;
+}
+// Empties the search box and removes the search filter, without running a search
+void MainWindow::ClearSearch()
+{
     {
-        switch (_SearchMode)
-        {
-            case 0:
-                if (resourceData[i].Version != 67 &&
-                    resourceData[i].Version != 31 &&
-                    resourceData[i].Version != 21 &&
-                    resourceData[i].Version != 1 &&
-                    resourceData[i].Version != 0)
-                    continue;
-                break;
-            case 1:
-                if (resourceData[i].Version != 0)
-                    continue;
-                break;
-            case 2:
-                if (resourceData[i].Version != 1)
-                    continue;
-                break;
-            case 3:
-                if (resourceData[i].Version != 21)
-                    continue;
-                break;
-            case 4:
-                if ((resourceData[i].Version != 31) && (resourceData[i].Version != 67))
-                    continue;
-                break;
-            default:
-                break;
-        }
-
-        // Filter out anything we didn't search for
-        if (searchWords.size() > 0)
-        {
-            _ViewIsFiltered = 1;
-            bool matched = 1;
-
-            for (int j = 0; j < searchWords.size(); j++)
-                if (resourceData[i].Name.find(searchWords[j]) == -1)
-                    matched = 0;
-
-            if (matched == 0)
-                continue;
-        }
-
-        // Filter out unsupported .lwo
-        if (resourceData[i].Version == 67)
-        {
-            if (resourceData[i].Name.rfind("world_") != -1 && (resourceData[i].Name.find("maps/game") != -1))
-                continue;
-
-            if (resourceData[i].Name.rfind(".bmodel") != -1)
-                continue;
-        }
-
-        // Filter out unsupported md6
-        if (resourceData[i].Version == 31)
-        {
-            if (resourceData[i].Name.rfind(".abc") != -1)
-                continue;
-        }
-
-        // Filter out unsupported images
-        if (resourceData[i].Version == 21)
-        {
-            if (resourceData[i].Name.rfind("/lightprobes/") != -1)
-                continue;
-        }
-
-        // Filter out unsupported "version 1" files
-        if (resourceData[i].Version == 1 && resourceData[i].Type != "compfile")
-            continue;
-
-        // Filter out unsupported "version 0" files
-        if (resourceData[i].Version == 0 && resourceData[i].Type != "rs_streamfile")
-            continue;
-
-        int row_count = ui->tableWidget->rowCount();
-        ui->tableWidget->insertRow(row_count);
-
-        // Set Resource Name
-        std::string resourceName = resourceData[i].Name;
-        QString qResourceName = QString::fromStdString(resourceName);
-        QTableWidgetItem *tableResourceName = new QTableWidgetItem(qResourceName);
-
-        // Set Resource Type
-        std::string resourceType = resourceData[i].Type;
-        QString qResourceType = QString::fromStdString(resourceType);
-        QTableWidgetItem *tableResourceType = new QTableWidgetItem(qResourceType);
-
-        // Set Resource Version
-        std::string resourceVersion = std::to_string(resourceData[i].Version);
-        QString qResourceVersion = QString::fromStdString(resourceVersion);
-        QTableWidgetItem *tableResourceVersion = new QTableWidgetItem(qResourceVersion);
-
-        // Set Resource Status
-        QTableWidgetItem *tableResourceStatus;
-
-        if (resourceData[i].Version == 31)
-            tableResourceStatus = new QTableWidgetItem("Experimental");
-        else
-            tableResourceStatus = new QTableWidgetItem("Loaded");
-
-        // Populate Table Row
-        ui->tableWidget->setItem(row_count, 0, tableResourceName);
-        ui->tableWidget->setItem(row_count, 1, tableResourceType);
-        ui->tableWidget->setItem(row_count, 2, tableResourceVersion);
-        ui->tableWidget->setItem(row_count, 3, tableResourceStatus);
+        const QSignalBlocker blocker(ui->inputSearch);
+        ui->inputSearch->clear();
     }
-
-    QString labelCount = QString::number(ui->tableWidget->rowCount());
+    _ResourceProxyModel->SetSearchMatches(NULL);
+    ui->btnClear->setVisible(false);
+    return;
+}
+void MainWindow::UpdateResourceCountLabel()
+{
+    QString labelCount = QString::number(_ResourceProxyModel->rowCount());
     QString labelText = "Found " + labelCount + " files.";
     ui->labelStatus->setText(labelText);
-
-    // Enable sorting again
-    ui->tableWidget->setSortingEnabled(true);
-
-    QHeaderView* tableHeader = ui->tableWidget->horizontalHeader();
-    tableHeader->setSectionResizeMode(0, QHeaderView::Stretch);
     return;
 }
 int MainWindow::ShowLoadStatus()
@@ -266,35 +183,37 @@ int MainWindow::ShowExportStatus()
 void MainWindow::on_btnExportSelected_clicked()
 {
     // Return if no items are selected for export
-    QList<QTableWidgetItem *> itemExportQList = ui->tableWidget->selectedItems();
-    if (itemExportQList.size() == 0)
+    QModelIndexList selectedRows = ui->tableView->selectionModel()->selectedRows();
+    if (selectedRows.size() == 0)
     {
         ThrowError("No items were selected for export.");
         return;
     }
 
-    // Iterate through table, add items to export list
+    // Iterate through selected rows, add items to export list
     std::vector<std::vector<std::string>> itemExportRows;
-    for (int64_t i = 0; i < itemExportQList.size(); i+=4)
+    for (int64_t i = 0; i < selectedRows.size(); i++)
     {
+        int row = _ResourceProxyModel->mapToSource(selectedRows[i]).row();
+        const HAYDEN::ResourceEntry& entry = _ResourceModel->GetEntry(row);
         std::vector<std::string> rowText = {
-            itemExportQList[i]->text().toStdString(),
-            itemExportQList[i+1]->text().toStdString(),
-            itemExportQList[i+2]->text().toStdString()
+            entry.Name,
+            entry.Type,
+            std::to_string(entry.Version)
         };
         itemExportRows.push_back(rowText);
-        itemExportQList[i+3]->setText("Exported");
+        _ResourceModel->SetExported(row);
     }
 
     // Export files in a separate thread
     _ExportThread = QThread::create(&HAYDEN::SAMUEL::ExportFiles, &SAM, _ExportPath, itemExportRows);
-    connect(_ExportThread, &QThread::finished, this, [this]()
+    size_t exportCount = itemExportRows.size();
+    connect(_ExportThread, &QThread::finished, this, [this, exportCount]()
     {
         if (_ExportStatusBox.isVisible())
             _ExportStatusBox.close();
 
-        QList<QTableWidgetItem *> itemExportQList = ui->tableWidget->selectedItems();
-        QString labelCount = QString::number(itemExportQList.size() / 4);
+        QString labelCount = QString::number(exportCount);
         QString labelText = "Exported " + labelCount + " files.";
 
         ui->labelStatus->setText(labelText);
@@ -314,12 +233,7 @@ void MainWindow::on_btnExportSelected_clicked()
     {
         _ExportThread->terminate();
         ui->labelStatus->setText("Export operation was cancelled.");
-
-        for (int64_t i = 0; i < ui->tableWidget->rowCount(); i++)
-        {
-            QTableWidgetItem* tableItem = ui->tableWidget->item(i, 3);
-            tableItem->setText("Loaded");
-        }
+        _ResourceModel->ClearExported();
     }
 
     return;
@@ -350,8 +264,16 @@ void MainWindow::on_btnLoadResource_clicked()
             return;
         }
 
+        // The table reads SAM's entries in place, detach it while they are replaced
         DisableGUI();
-        _LoadResourceThread = QThread::create(&HAYDEN::SAMUEL::LoadResource, &SAM, _ResourcePath);
+        ClearSearch();
+        _ResourceModel->Clear();
+        _SearchIndex.Clear();
+        _LoadResourceThread = QThread::create([this]()
+        {
+            if (SAM.LoadResource(_ResourcePath))
+                _SearchIndex.Build(SAM.GetResourceData());
+        });
 
         connect(_LoadResourceThread, &QThread::finished, this, [this]()
         {
@@ -382,7 +304,7 @@ void MainWindow::on_btnLoadResource_clicked()
             _LoadResourceThread->terminate();
     }
 }
-void MainWindow::on_tableWidget_itemDoubleClicked(QTableWidgetItem *item)
+void MainWindow::on_tableView_doubleClicked(const QModelIndex &index)
 {
     on_btnExportSelected_clicked();
     return;
@@ -392,12 +314,7 @@ void MainWindow::on_btnSearch_clicked()
     if (ui->inputSearch->text().isEmpty())
         return;
 
-    std::string searchText = ui->inputSearch->text().toStdString();
-    std::vector<std::string> searchWords = SplitSearchTerms(searchText);
-
-    PopulateGUIResourceTable(searchWords);
-
-    ui->btnClear->setVisible(true);
+    ApplySearch(ui->inputSearch->text());
     return;
 }
 void MainWindow::on_inputSearch_returnPressed()
@@ -405,19 +322,26 @@ void MainWindow::on_inputSearch_returnPressed()
     on_btnSearch_clicked();
     return;
 }
+void MainWindow::on_inputSearch_textChanged(const QString &text)
+{
+    // Nothing to filter while a .resources file is loading
+    if (!ui->inputSearch->isEnabled())
+        return;
+
+    ApplySearch(text);
+    return;
+}
 void MainWindow::on_btnClear_clicked()
 {
-    ui->btnClear->setVisible(false);
-    ui->inputSearch->setText("");
-    PopulateGUIResourceTable();
+    ClearSearch();
+    UpdateResourceCountLabel();
     return;
 }
 void MainWindow::on_radioShowAll_toggled(bool checked)
 {
     if (checked)
     {
-        _SearchMode = 0;
-        PopulateGUIResourceTable();
+        SetSearchMode(0);
     }
     return;
 }
@@ -425,8 +349,7 @@ void MainWindow::on_radioShowDecl_toggled(bool checked)
 {
     if (checked)
     {
-        _SearchMode = 1;
-        PopulateGUIResourceTable();
+        SetSearchMode(1);
     }
     return;
 }
@@ -434,8 +357,7 @@ void MainWindow::on_radioShowEntities_toggled(bool checked)
 {
     if (checked)
     {
-        _SearchMode = 2;
-        PopulateGUIResourceTable();
+        SetSearchMode(2);
     }
     return;
 }
@@ -443,8 +365,7 @@ void MainWindow::on_radioShowImages_toggled(bool checked)
 {
     if (checked)
     {
-        _SearchMode = 3;
-        PopulateGUIResourceTable();
+        SetSearchMode(3);
     }
     return;
 }
@@ -452,8 +373,7 @@ void MainWindow::on_radioShowModels_toggled(bool checked)
 {
     if (checked)
     {
-        _SearchMode = 4;
-        PopulateGUIResourceTable();
+        SetSearchMode(4);
     }
     return;
 }
\ No newline at end of file
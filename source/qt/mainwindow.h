@@ -4,9 +4,11 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QThread>
-#include <QTableWidgetItem>
+#include <QModelIndex>
+#include <QSignalBlocker>
 
 #include "../core/SAMUEL.h"
+#include "resourcetablemodel.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -27,9 +29,10 @@ class MainWindow : public QMainWindow
         void on_btnLoadResource_clicked();
         void on_btnExportSelected_clicked();
         void on_btnSearch_clicked();
-        void on_tableWidget_itemDoubleClicked(QTableWidgetItem *item);
+        void on_tableView_doubleClicked(const QModelIndex &index);
         void on_btnClear_clicked();
         void on_inputSearch_returnPressed();
+        void on_inputSearch_textChanged(const QString &text);
         void on_radioShowAll_toggled(bool checked);
         void on_radioShowDecl_toggled(bool checked);
         void on_radioShowEntities_toggled(bool checked);
@@ -45,18 +48,23 @@ class MainWindow : public QMainWindow
         std::string _ExportPath;
         std::string _ResourcePath;
         bool _ResourceFileIsLoaded = 0;
-        bool _ViewIsFiltered = 0;
-        int _SearchMode = 0;
 
         HAYDEN::SAMUEL SAM;
         Ui::MainWindow *ui;
+        ResourceTableModel* _ResourceModel = NULL;
+        ResourceFilterProxyModel* _ResourceProxyModel = NULL;
+        HAYDEN::ResourceSearchIndex _SearchIndex;   // built with the entries, on the load thread
 
         int  ShowLoadStatus();
         int  ShowExportStatus();
         void DisableGUI();
         void EnableGUI();
         void ResetGUITable();
-        void PopulateGUIResourceTable(std::vector<std::string> searchWords = std::vector<std::string>());
+        void PopulateGUIResourceTable();
+        void SetSearchMode(const int searchMode);
+        void UpdateResourceCountLabel();
+        void ApplySearch(const QString &searchText);
+        void ClearSearch();
 
         // Splits search query by whitespace
         std::vector<std::string> SplitSearchTerms(std::string inputString);
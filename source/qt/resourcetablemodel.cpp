@@ -0,0 +1,163 @@
+#include "resourcetablemodel.h"
+
+// ResourceTableModel
+void ResourceTableModel::SetEntries(const std::vector<HAYDEN::ResourceEntry>* entries)
+{
+    beginResetModel();
+    _Entries = entries;
+    _EntryIndexes.clear();
+
+    if (_Entries != NULL)
+    {
+        for (size_t i = 0; i < _Entries->size(); i++)
+        {
+            if (HAYDEN::ExportManager::IsExportSupported((*_Entries)[i]))
+                _EntryIndexes.push_back(i);
+        }
+    }
+
+    _Exported.assign(_EntryIndexes.size(), 0);
+    endResetModel();
+    return;
+}
+void ResourceTableModel::SetExported(const int row)
+{
+    _Exported[row] = 1;
+    QModelIndex statusIndex = index(row, StatusColumn);
+    emit dataChanged(statusIndex, statusIndex);
+    return;
+}
+void ResourceTableModel::ClearExported()
+{
+    if (_Exported.empty())
+        return;
+
+    _Exported.assign(_Exported.size(), 0);
+    emit dataChanged(index(0, StatusColumn), index((int)_Exported.size() - 1, StatusColumn));
+    return;
+}
+int ResourceTableModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : (int)_EntryIndexes.size();
+}
+int ResourceTableModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+QVariant ResourceTableModel::data(const QModelIndex& index, int role) const
+{
+    if (role != Qt::DisplayRole || !index.isValid() || index.row() >= (int)_EntryIndexes.size())
+        return QVariant();
+
+    const HAYDEN::ResourceEntry& entry = GetEntry(index.row());
+    switch (index.column())
+    {
+        case NameColumn:
+            return QString::fromStdString(entry.Name);
+        case TypeColumn:
+            return QString::fromStdString(entry.Type);
+        case VersionColumn:
+            return entry.Version;
+        case StatusColumn:
+            if (_Exported[index.row()])
+                return QStringLiteral("Exported");
+            return entry.Version == 31 ? QStringLiteral("Experimental") : QStringLiteral("Loaded");
+        default:
+            return QVariant();
+    }
+}
+QVariant ResourceTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal)
+        return QVariant();
+
+    switch (section)
+    {
+        case NameColumn:
+            return QStringLiteral("Name");
+        case TypeColumn:
+            return QStringLiteral("Type");
+        case VersionColumn:
+            return QStringLiteral("Version");
+        case StatusColumn:
+            return QStringLiteral("Status");
+        default:
+            return QVariant();
+    }
+}
+
+// ResourceFilterProxyModel
+void ResourceFilterProxyModel::SetSearchMode(const int searchMode)
+{
+    _SearchMode = searchMode;
+    invalidateFilter();
+    return;
+}
+void ResourceFilterProxyModel::SetSearchMatches(const std::vector<uint32_t>* searchMatches)
+{
+    _IsSearchFiltered = searchMatches != NULL;
+    _SearchMatches.clear();
+
+    if (_IsSearchFiltered && !searchMatches->empty())
+    {
+        // Matches are sorted, the last one is the highest index
+        _SearchMatches.resize(searchMatches->back() + 1);
+        for (size_t i = 0; i < searchMatches->size(); i++)
+            _SearchMatches[(*searchMatches)[i]] = 1;
+    }
+
+    invalidateFilter();
+    return;
+}
+bool ResourceFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
+{
+    const HAYDEN::ResourceEntry& entry = GetResourceModel()->GetEntry(sourceRow);
+
+    switch (_SearchMode)
+    {
+        case 1:
+            if (entry.Version != 0)
+                return 0;
+            break;
+        case 2:
+            if (entry.Version != 1)
+                return 0;
+            break;
+        case 3:
+            if (entry.Version != 21)
+                return 0;
+            break;
+        case 4:
+            if (entry.Version != 31 && entry.Version != 67)
+                return 0;
+            break;
+        default:
+            break;
+    }
+
+    // Filter out anything we didn't search for
+    if (_IsSearchFiltered)
+    {
+        size_t entryIndex = GetResourceModel()->GetEntryIndex(sourceRow);
+        return entryIndex < _SearchMatches.size() && _SearchMatches[entryIndex];
+    }
+    return 1;
+}
+bool ResourceFilterProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
+{
+    const ResourceTableModel* resourceModel = GetResourceModel();
+    const HAYDEN::ResourceEntry& leftEntry = resourceModel->GetEntry(left.row());
+    const HAYDEN::ResourceEntry& rightEntry = resourceModel->GetEntry(right.row());
+
+    switch (left.column())
+    {
+        case ResourceTableModel::NameColumn:
+            return leftEntry.Name < rightEntry.Name;
+        case ResourceTableModel::TypeColumn:
+            return leftEntry.Type < rightEntry.Type;
+        case ResourceTableModel::VersionColumn:
+            return leftEntry.Version < rightEntry.Version;
+        default:
+            return QSortFilterProxyModel::lessThan(left, right);
+    }
+}
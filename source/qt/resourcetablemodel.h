@@ -0,0 +1,76 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <QAbstractTableModel>
+#include <QSortFilterProxyModel>
+
+#include "../core/SAMUEL.h"
+
+// Exportable entries of the loaded .resources file, read in place from SAMUEL.
+// Cells are only converted to QString when the view asks for them.
+class ResourceTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+    public:
+        enum Column
+        {
+            NameColumn = 0,
+            TypeColumn = 1,
+            VersionColumn = 2,
+            StatusColumn = 3,
+            ColumnCount = 4
+        };
+
+        // entries must not change until the next SetEntries or Clear call
+        void SetEntries(const std::vector<HAYDEN::ResourceEntry>* entries);
+        void Clear() { SetEntries(NULL); }
+        const HAYDEN::ResourceEntry& GetEntry(const int row) const { return (*_Entries)[_EntryIndexes[row]]; }
+
+        // Index of a row's entry in the vector passed to SetEntries
+        size_t GetEntryIndex(const int row) const { return _EntryIndexes[row]; }
+
+        // Status column shows "Exported" for these rows
+        void SetExported(const int row);
+        void ClearExported();
+
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+        ResourceTableModel(QObject* parent = NULL) : QAbstractTableModel(parent) {}
+
+    private:
+        const std::vector<HAYDEN::ResourceEntry>* _Entries = NULL;
+        std::vector<size_t> _EntryIndexes;          // supported entries only, in .resources order
+        std::vector<bool> _Exported;
+};
+
+// Filters ResourceTableModel rows by type and search results, and sorts them without building QStrings
+class ResourceFilterProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+    public:
+        // 0 = all, 1 = decls, 2 = entities (compfiles), 3 = images, 4 = models
+        void SetSearchMode(const int searchMode);
+
+        // Only show entries in searchMatches (entry indexes, as returned by ResourceSearchIndex). NULL = no filter.
+        void SetSearchMatches(const std::vector<uint32_t>* searchMatches);
+
+        ResourceFilterProxyModel(QObject* parent = NULL) : QSortFilterProxyModel(parent) {}
+
+    protected:
+        bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
+        bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
+
+    private:
+        int _SearchMode = 0;
+        bool _IsSearchFiltered = 0;
+        std::vector<bool> _SearchMatches;           // by entry index
+
+        const ResourceTableModel* GetResourceModel() const { return static_cast<const ResourceTableModel*>(sourceModel()); }
+};